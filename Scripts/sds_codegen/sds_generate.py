@@ -1924,7 +1924,6 @@ extension %sSerializer {
         # ---- Fetch ----
 
         cached_method = "anyFetch"
-        uncached_method = "anyFetch"
         if cache_get_code_for_class(clazz) is not None:
             cached_method = "fetchViaCache"
 
@@ -1989,18 +1988,28 @@ public extension %(class_name)s {
             return
         }
 
-        guard let dbCopy = type(of: self).%(uncached_method)s(uniqueId: uniqueId, transaction: transaction) else {
+        // Load the record along with the model so that we only write back
+        // the columns that the block (or the update hooks) actually changed.
+        let dbRecord: %(record_name)s
+        let dbCopy: %(class_name)s
+        do {
+            let sql = "SELECT * FROM \\(%(record_name)s.databaseTableName) WHERE \\(%(record_identifier)sColumn: .uniqueId) = ?"
+            let sqlRequest = SQLRequest<Void>(sql: sql, arguments: [uniqueId], cached: true)
+            guard let record = try %(record_name)s.fetchOne(transaction.database, sqlRequest) else {
+                return
+            }
+            dbRecord = record
+            dbCopy = try %(class_name)s.fromRecord(record)
+        } catch {
+            owsFailDebug("error: \\(error)")
             return
         }
 
-        // Don't apply the block twice to the same instance.
-        // It's at least unnecessary and actually wrong for some blocks.
-        // e.g. `block: { $0 in $0.someField++ }`
-        if dbCopy !== self {
-            block(dbCopy)
-        }
+        // dbCopy is always a fresh instance, so this never applies the block
+        // twice to the same instance.
+        block(dbCopy)
 
-        dbCopy.sdsSave(saveMode: .update, transaction: transaction)
+        dbCopy.sdsUpdateChangedColumns(from: dbRecord, transaction: transaction)
     }
 
     // This method is an alternative to `anyUpdate(transaction:block:)` methods.
@@ -2018,7 +2027,8 @@ public extension %(class_name)s {
 """ % {
             "class_name": str(clazz.name),
             "cached_method": cached_method,
-            "uncached_method": uncached_method,
+            "record_name": record_name,
+            "record_identifier": record_identifier(clazz.name),
         }
 
         if has_remove_methods:
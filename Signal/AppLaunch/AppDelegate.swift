@@ -503,7 +503,7 @@ final class AppDelegate: UIResponder, UIApplicationDelegate {
             Task { @MainActor in
                 defer { backgroundTask.end() }
                 if !hasInProgressRegistration {
-                    await LaunchJobs.run(databaseStorage: SSKEnvironment.shared.databaseStorageRef)
+                    await LaunchJobs.run(maintenanceScheduler: finalContinuation.dependenciesBridge.maintenanceScheduler)
                 }
                 DispatchQueue.main.async {
                     self.setAppIsReady(
@@ -528,13 +528,17 @@ final class AppDelegate: UIResponder, UIApplicationDelegate {
         let dependenciesBridge = DependenciesBridge.shared
         let cron = dependenciesBridge.cron
 
+        let maintenanceScheduler = dependenciesBridge.maintenanceScheduler
         let messageSendLog = SSKEnvironment.shared.messageSendLogRef
-        cron.schedulePeriodically(
+        maintenanceScheduler.register(
             uniqueKey: .cleanUpMessageSendLog,
             approximateInterval: .day,
+            step: messageSendLog.cleanUpSomeExpiredEntries(tx:),
+        )
+        cron.scheduleFrequently(
             mustBeRegistered: false,
             mustBeConnected: false,
-            operation: { try await messageSendLog.cleanUpExpiredEntries() },
+            operation: { await maintenanceScheduler.runDueTasks() },
         )
 
         var orphanedDataCleanerFailureCount = 0
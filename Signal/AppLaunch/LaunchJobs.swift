@@ -7,7 +7,7 @@ import Foundation
 import SignalServiceKit
 
 enum LaunchJobs {
-    static func run(databaseStorage: SDSDatabaseStorage) async {
+    static func run(maintenanceScheduler: MaintenanceScheduler) async {
         // Getting this work done ASAP is super high priority since we won't finish
         // launching until the completion block is fired.
         //
@@ -18,10 +18,10 @@ enum LaunchJobs {
         // Mark all "attempting out" messages as "unsent", i.e. any messages that
         // were not successfully sent before the app exited should be marked as
         // failures.
-        await FailedMessagesJob().run(databaseStorage: databaseStorage)
+        await FailedMessagesJob().run(maintenanceScheduler: maintenanceScheduler)
         // Mark all "incomplete" calls as missed, e.g. any incoming or outgoing
         // calls that were not connected, failed or hung up before the app existed
         // should be marked as missed.
-        await IncompleteCallsJob().run(databaseStorage: databaseStorage)
+        await IncompleteCallsJob().run(maintenanceScheduler: maintenanceScheduler)
     }
 }
@@ -198,6 +198,14 @@ public class CVLoader: NSObject {
                     localAci: localAci,
                 )
 
+                // Items are loaded ahead of being displayed, so this gives us a
+                // head start on their waveforms.
+                DependenciesBridge.shared.audioWaveformManager.prefetchCachedAudioWaveforms(
+                    attachmentStreams: itemModels.compactMap {
+                        $0.componentState.audioAttachment?.attachmentStream?.attachmentStream
+                    },
+                )
+
                 let items = itemModels.compactMap { item in
                     Self.buildRenderItem(
                         itemBuildingContext: loadContext,
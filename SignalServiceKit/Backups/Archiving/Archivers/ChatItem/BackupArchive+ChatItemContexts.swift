@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: AGPL-3.0-only
 //
 
+import GRDB
+
 extension BackupArchive {
 
     public class ChatItemRestoringContext: RestoringContext {
@@ -13,6 +15,10 @@ extension BackupArchive {
 
         public var uploadEra: String? { chatContext.customChatColorContext.accountDataContext.uploadEra }
 
+        /// The compiled "insert interaction" statement, held for the duration
+        /// of the restore so each insert can skip the statement cache lookup.
+        var interactionInsertStatement: GRDB.Statement?
+
         init(
             accountDataContext: AccountDataRestoringContext,
             chatContext: ChatRestoringContext,
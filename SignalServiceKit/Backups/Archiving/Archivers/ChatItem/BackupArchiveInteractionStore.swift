@@ -173,7 +173,7 @@ public final class BackupArchiveInteractionStore {
         // and restore, we'll only send back a Null message. (Until such a day
         // when resends use the interactions table and not MSL at all).
 
-        try insertInteractionWithDirectSQLiteCalls(interaction, database: context.tx.database)
+        try insertInteractionWithDirectSQLiteCalls(interaction, context: context)
         interaction.updateRowId(context.tx.database.lastInsertedRowID)
 
         guard let interactionRowId = interaction.sqliteRowId else {
@@ -234,8 +234,9 @@ public final class BackupArchiveInteractionStore {
     /// over hundreds of thousands of interaction inserts during a restore are.
     private func insertInteractionWithDirectSQLiteCalls(
         _ interaction: TSInteraction,
-        database: GRDB.Database,
+        context: BackupArchive.ChatItemRestoringContext,
     ) throws {
+        let database = context.tx.database
         guard let sqliteConnection = database.sqliteConnection else {
             throw OWSAssertionError("Missing SQLite connection!")
         }
@@ -250,43 +251,39 @@ public final class BackupArchiveInteractionStore {
         /// tricky pointer math. GRDB then holds a reference to that compiled
         /// statement pointer in a package-level cache, from which we can
         /// retrieve it.
-        let cachedSqliteStatement: GRDB.SQLiteStatement = try database.cachedStatement(
-            sql: insertInteractionSQL,
-        ).sqliteStatement
+        ///
+        /// Looking the statement up in that cache means hashing the (long)
+        /// SQL string, so we also hold onto it in the restoring context and
+        /// skip the lookup for every insert after the first.
+        let cachedStatement: GRDB.Statement
+        if let interactionInsertStatement = context.interactionInsertStatement {
+            cachedStatement = interactionInsertStatement
+        } else {
+            cachedStatement = try database.cachedStatement(sql: insertInteractionSQL)
+            context.interactionInsertStatement = cachedStatement
+        }
+        let cachedSqliteStatement: GRDB.SQLiteStatement = cachedStatement.sqliteStatement
 
         /// The compiled "insert interaction" SQLite statement contains `?`
         /// placeholders, which must have real values "bound" to them before the
         /// statement can be used to actually insert a database row. Those bound
         /// values are specific to each interaction being inserted; so, before
-        /// we can use the cached statement we must reset any values from
-        /// previous interaction inserts and bind new values.
-        var sqliteReturnCode: Int32
-
-        // Reset the cached statement.
-        sqliteReturnCode = sqlite3_reset(cachedSqliteStatement)
+        /// we can use the cached statement we must reset it and bind new
+        /// values. Every argument is rebound (`nil` as `NULL`), so there's no
+        /// need to separately clear the previous bindings.
+        let sqliteReturnCode = sqlite3_reset(cachedSqliteStatement)
         guard sqliteReturnCode == SQLITE_OK else {
             let errmsg = String(cString: sqlite3_errmsg(sqliteConnection)!)
             throw OWSAssertionError("Failed to reset interaction insert statement! \(errmsg)")
         }
 
-        // Clear any previously bound arguments.
-        sqliteReturnCode = sqlite3_clear_bindings(cachedSqliteStatement)
-        guard sqliteReturnCode == SQLITE_OK else {
-            let errmsg = String(cString: sqlite3_errmsg(sqliteConnection)!)
-            throw OWSAssertionError("Failed to clear argument bindings from interaction insert statement! \(errmsg)")
-        }
-
         // Bind new values from the current interaction.
         let args = (interaction.asRecord() as! InteractionRecord).asValues()
         var count: Int32 = 1
         for arg in args {
             defer { count += 1 }
 
-            guard let arg else {
-                continue
-            }
-
-            let code = arg.databaseValue.bind(to: cachedSqliteStatement, at: count)
+            let code = (arg?.databaseValue ?? .null).bind(to: cachedSqliteStatement, at: count)
             guard code == SQLITE_OK else {
                 let errmsg = String(cString: sqlite3_errmsg(sqliteConnection)!)
                 throw OWSAssertionError("Failed to bind argument to interaction insert statement! \(errmsg)")
@@ -55,6 +55,7 @@ final class BackupArchiveGroupUpdateMessageArchiver {
                 newGroupModel: new.groupModel,
                 oldDisappearingMessageToken: old.dmToken,
                 newDisappearingMessageToken: new.dmToken,
+                changedMemberServiceIds: nil,
                 localIdentifiers: context.recipientContext.localIdentifiers,
                 groupUpdateSource: source,
                 tx: context.tx,
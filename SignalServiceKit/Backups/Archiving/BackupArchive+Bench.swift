@@ -10,6 +10,30 @@ extension BackupArchive {
     /// A `Bencher` specialized for measuring Backup archiving.
     class ArchiveBencher: Bencher {
 
+        /// Input processed by one stage of writing the Backup file.
+        struct StageMetrics {
+            let name: String
+            let byteCount: UInt64
+            let durationNanos: UInt64
+        }
+
+        /// Set once the output stream is closed, to be logged with the results.
+        var stageMetrics = [StageMetrics]()
+
+        override func logResults() {
+            super.logResults()
+
+            guard !stageMetrics.isEmpty else {
+                return
+            }
+            logger.info("Output Stage Metrics:")
+            for metrics in stageMetrics {
+                guard metrics.durationNanos > 0 else { continue }
+                let megabytesPerSecond = Double(metrics.byteCount) / 1_000_000 * Double(NSEC_PER_SEC) / Double(metrics.durationNanos)
+                logger.info("\(metrics.name): \(metrics.durationNanos / NSEC_PER_MSEC)ms. \(String(format: "%.1f", megabytesPerSecond))MB/s")
+            }
+        }
+
         /// Wrap the given enumeration method to facilitate measurement of the
         /// time spent.
         ///
@@ -68,6 +92,8 @@ extension BackupArchive {
 
         private var preFrameRestoreMetrics = [PreFrameRestoreAction: Metrics]()
         private var postFrameRestoreMetrics = [PostFrameRestoreAction: Metrics]()
+        /// Time spent waiting for frames to be read, decrypted and parsed.
+        private var frameReadMetrics = Metrics()
 
         override func logResults() {
             logger.info("Pre-Frame Restore Metrics:")
@@ -77,10 +103,47 @@ extension BackupArchive {
 
             super.logResults()
 
+            logger.info("Frame Read Metrics:")
+            logMetrics(frameReadMetrics, typeString: "FrameRead")
+
             logger.info("Post-Frame Restore Metrics:")
             for (action, metrics) in self.postFrameRestoreMetrics.sorted(by: { $0.value.totalDurationMs > $1.value.totalDurationMs }) {
                 logMetrics(metrics, typeString: action.rawValue)
             }
+
+            logChatItemThroughput()
+        }
+
+        /// Logs how many chat items (messages and chat updates) we restored
+        /// per second, both overall and counting only the time spent
+        /// processing chat item frames.
+        private func logChatItemThroughput() {
+            let chatItemMetrics = frameProcessingMetrics
+                .filter { $0.key.rawValue.hasPrefix("ChatItem_") }
+                .values
+            let chatItemCount = chatItemMetrics.reduce(0, { $0 + $1.frameCount })
+            let chatItemDurationNanos = chatItemMetrics.reduce(0, { $0 + $1.totalDurationNanos })
+            let totalDurationNanos = (dateProvider() - startDate).nanoseconds
+            guard chatItemCount > 0, chatItemDurationNanos > 0, totalDurationNanos > 0 else {
+                return
+            }
+
+            func perSecond(_ durationNanos: UInt64) -> UInt64 {
+                return UInt64(Double(chatItemCount) * Double(NSEC_PER_SEC) / Double(durationNanos))
+            }
+            logger.info("Restored \(loggableCountString(chatItemCount)) chat items. Overall:\(perSecond(totalDurationNanos))/s ChatItem frames:\(perSecond(chatItemDurationNanos))/s")
+        }
+
+        func benchFrameRead<T>(_ block: () throws -> T) rethrows -> T {
+            let startDate = dateProvider()
+            let result = try block()
+            let durationNanos = (dateProvider() - startDate).nanoseconds
+
+            frameReadMetrics.frameCount += 1
+            frameReadMetrics.totalDurationNanos += durationNanos
+            frameReadMetrics.maxDurationNanos = max(durationNanos, frameReadMetrics.maxDurationNanos)
+
+            return result
         }
 
         func benchPreFrameRestoreAction<T>(_ action: PreFrameRestoreAction, _ block: () throws -> T) rethrows -> T {
@@ -236,7 +299,7 @@ extension BackupArchive {
             logger.info(logString)
         }
 
-        private func loggableCountString(_ number: UInt64) -> String {
+        fileprivate func loggableCountString(_ number: UInt64) -> String {
             if BuildFlags.Backups.detailedBenchLogging {
                 return "\(number)"
             }
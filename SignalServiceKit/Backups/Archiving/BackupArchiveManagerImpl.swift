@@ -712,6 +712,7 @@ public class BackupArchiveManagerImpl: BackupArchiveManager {
             try stream.closeFileStream()
 
             logger.info("Finished exporting backup")
+            bencher.stageMetrics = stream.stageMetrics()
             bencher.logResults()
         })
         processErrors(errors: errors, didFail: !result.isSuccess)
@@ -1087,11 +1088,16 @@ public class BackupArchiveManagerImpl: BackupArchiveManager {
                 tx: tx,
             )
 
+            // Frames are read and parsed on another queue while we apply
+            // the ones already read.
+            let frameReader = BackupArchivePrefetchingFrameReader(stream: stream)
+            defer { frameReader.stop() }
+
             while hasMoreFrames {
                 try Task.checkCancellation()
                 try autoreleasepool {
                     let frame: BackupProto_Frame?
-                    switch stream.readFrame() {
+                    switch bencher.benchFrameRead({ frameReader.readFrame() }) {
                     case let .success(_frame, moreBytesAvailable):
                         frame = _frame
                         hasMoreFrames = moreBytesAvailable
@@ -1297,6 +1303,7 @@ public class BackupArchiveManagerImpl: BackupArchiveManager {
                 }
             }
 
+            frameReader.stop()
             stream.closeFileStream()
 
             // Now that we've imported successfully, we want to recreate the
@@ -0,0 +1,129 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Reads frames from a ``BackupArchiveProtoInputStream`` on a background
+/// queue, ahead of the caller.
+///
+/// Reading a frame means pulling bytes through HMAC validation, decryption and
+/// decompression and then parsing the proto. Doing that ahead of time on
+/// another queue takes it off the restoring thread, which only has to apply
+/// each frame. Frames are returned in the order they appear in the file.
+///
+/// Frames are handed over in batches of `batchSize`, with at most
+/// `maxPendingBatchCount` read and not yet returned.
+///
+/// - Important
+/// Once this is created, the stream must not be read from directly. Call
+/// `stop()` before closing the stream.
+final class BackupArchivePrefetchingFrameReader {
+    typealias ReadResult = BackupArchive.ProtoInputStreamReadResult<BackupProto_Frame>
+
+    private struct State {
+        var batches = [[ReadResult]]()
+        var isStopped = false
+    }
+
+    private let stream: BackupArchiveProtoInputStream
+    private let batchSize: Int
+    private let queue = DispatchQueue(label: "org.signal.backup-restore.read-frames", autoreleaseFrequency: .workItem)
+    private let state = TSMutex(initialState: State())
+    /// Signaled for each batch added to `state`, and once more after the last.
+    private let readyBatchSemaphore = DispatchSemaphore(value: 0)
+    private let freeBatchSemaphore: DispatchSemaphore
+
+    /// Only accessed by the caller of `readFrame()`.
+    private var currentBatch = [ReadResult]()
+    private var currentBatchIndex = 0
+
+    init(
+        stream: BackupArchiveProtoInputStream,
+        batchSize: Int = 64,
+        maxPendingBatchCount: Int = 8,
+    ) {
+        owsPrecondition(batchSize > 0 && maxPendingBatchCount > 0)
+        self.stream = stream
+        self.batchSize = batchSize
+        // Start from zero and signal up to the limit: dispatch crashes if a
+        // semaphore is freed below its initial value, which happens when we
+        // stop with batches that were never read.
+        self.freeBatchSemaphore = DispatchSemaphore(value: 0)
+        for _ in 0..<maxPendingBatchCount {
+            freeBatchSemaphore.signal()
+        }
+
+        queue.async { [self] in
+            readFrames()
+        }
+    }
+
+    /// Returns the next frame from the stream, waiting for it to be read if
+    /// needed. Behaves like ``BackupArchiveProtoInputStream/readFrame()``,
+    /// except that it returns `.emptyFinalFrame` if called again after the
+    /// stream has ended.
+    func readFrame() -> ReadResult {
+        if currentBatchIndex == currentBatch.count {
+            readyBatchSemaphore.wait()
+            let nextBatch = state.withLock { state -> [ReadResult]? in
+                return state.batches.isEmpty ? nil : state.batches.removeFirst()
+            }
+            guard let nextBatch else {
+                // The reader is done; leave the final signal for later calls.
+                readyBatchSemaphore.signal()
+                return .emptyFinalFrame
+            }
+            freeBatchSemaphore.signal()
+            currentBatch = nextBatch
+            currentBatchIndex = 0
+        }
+        defer { currentBatchIndex += 1 }
+        return currentBatch[currentBatchIndex]
+    }
+
+    /// Stops reading ahead, and waits for any in-progress read to finish.
+    func stop() {
+        state.withLock { $0.isStopped = true }
+        // Wake the reader if it's waiting for room for another batch.
+        freeBatchSemaphore.signal()
+        queue.sync {}
+    }
+
+    // MARK: -
+
+    private func readFrames() {
+        var hasReadLastFrame = false
+        defer {
+            // Lets the caller know there are no more batches coming.
+            readyBatchSemaphore.signal()
+        }
+
+        while !hasReadLastFrame {
+            freeBatchSemaphore.wait()
+            if state.withLock({ $0.isStopped }) {
+                return
+            }
+
+            var batch = [ReadResult]()
+            batch.reserveCapacity(batchSize)
+            while batch.count < batchSize, !hasReadLastFrame {
+                let result = autoreleasepool { stream.readFrame() }
+                batch.append(result)
+                switch result {
+                case .success(_, let moreBytesAvailable):
+                    hasReadLastFrame = !moreBytesAvailable
+                case .emptyFinalFrame, .invalidByteLengthDelimiter:
+                    hasReadLastFrame = true
+                case .protoDeserializationError:
+                    // The caller decides whether to carry on past this.
+                    break
+                }
+            }
+
+            state.withLock { $0.batches.append(batch) }
+            readyBatchSemaphore.signal()
+        }
+    }
+}
@@ -25,17 +25,42 @@ extension BackupArchive {
  * the individual proto objects that we write one at a time.
  */
 class BackupArchiveProtoOutputStream {
+    /// One of the transforming streams that serialized frames pass through
+    /// on their way to disk.
+    struct TransformedOutputStream {
+        let name: String
+        let stream: TransformingOutputStream
+    }
+
     private let outputStream: OutputStreamable
+    private let transformedOutputStreams: [TransformedOutputStream]
     private let exportProgress: BackupArchiveExportProgress?
 
+    private var serializedByteCount: UInt64 = 0
+    private var serializationDurationNanos: UInt64 = 0
+
     init(
         outputStream: OutputStreamable,
+        transformedOutputStreams: [TransformedOutputStream] = [],
         exportProgress: BackupArchiveExportProgress?,
     ) {
         self.outputStream = outputStream
+        self.transformedOutputStreams = transformedOutputStreams
         self.exportProgress = exportProgress
     }
 
+    /// The bytes taken in and time spent by each stage of writing the file so
+    /// far: serializing frames, then each transforming stream.
+    ///
+    /// Only complete once the stream has been closed.
+    func stageMetrics() -> [BackupArchive.ArchiveBencher.StageMetrics] {
+        return [
+            .init(name: "Serialize", byteCount: serializedByteCount, durationNanos: serializationDurationNanos),
+        ] + transformedOutputStreams.map {
+            .init(name: $0.name, byteCount: $0.stream.inputByteCount, durationNanos: $0.stream.transformDurationNanos)
+        }
+    }
+
     /// Write a header (``BackupProto_BackupInfo``) to the backup file.
     ///
     /// - Important
@@ -61,7 +86,10 @@ class BackupArchiveProtoOutputStream {
     func writeFrame(_ frame: BackupProto_Frame) -> BackupArchive.ProtoOutputStreamWriteResult {
         let bytes: Data
         do {
+            let startDate = MonotonicDate()
             bytes = try frame.serializedData()
+            serializationDurationNanos += (MonotonicDate() - startDate).nanoseconds
+            serializedByteCount += UInt64(bytes.count)
         } catch {
             return .protoSerializationError(error)
         }
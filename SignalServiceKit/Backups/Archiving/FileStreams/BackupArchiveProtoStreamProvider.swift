@@ -58,12 +58,12 @@ public class BackupArchivePlaintextProtoStreamProvider {
     func openPlaintextOutputFileStream(
         exportProgress: BackupArchiveExportProgress?,
     ) -> ProtoStream.OpenOutputStreamResult<URL> {
-        let transforms: [any StreamTransform] = [
-            ChunkedOutputStreamTransform(),
+        let transformStages: [GenericStreamProvider.TransformStage] = [
+            .init(name: "Chunk", transforms: [ChunkedOutputStreamTransform()]),
         ]
 
         return genericStreamProvider.openOutputFileStream(
-            transforms: transforms,
+            transformStages: transformStages,
             exportProgress: exportProgress,
         )
     }
@@ -118,22 +118,28 @@ public class BackupArchiveEncryptedProtoStreamProvider {
         do {
             let outputTrackingTransform = MetadataStreamTransform()
 
-            let transforms: [any StreamTransform] = [
-                ChunkedOutputStreamTransform(),
-                try GzipStreamTransform(.compress),
-                try EncryptingStreamTransform(
-                    iv: Randomness.generateRandomBytes(UInt(Cryptography.Constants.aescbcIVLength)),
-                    encryptionKey: backupEncryptionKey.aesKey,
-                ),
-                try HmacStreamTransform(hmacKey: backupEncryptionKey.hmacKey, operation: .generate),
-                encryptionMetadata.metadataHeader.map(NonceHeaderOutputStreamTransform.init(metadataHeader:)),
-                outputTrackingTransform,
-            ].compacted()
+            // Compression, encryption and the hmac each run on their own
+            // queue, so they overlap with each other and with building frames.
+            let transformStages: [GenericStreamProvider.TransformStage] = [
+                .init(name: "Chunk", transforms: [ChunkedOutputStreamTransform()]),
+                .init(name: "Compress", transforms: [try GzipStreamTransform(.compress)]),
+                .init(name: "Encrypt", transforms: [
+                    try EncryptingStreamTransform(
+                        iv: Randomness.generateRandomBytes(UInt(Cryptography.Constants.aescbcIVLength)),
+                        encryptionKey: backupEncryptionKey.aesKey,
+                    ),
+                ]),
+                .init(name: "HMAC", transforms: [
+                    try HmacStreamTransform(hmacKey: backupEncryptionKey.hmacKey, operation: .generate),
+                    encryptionMetadata.metadataHeader.map(NonceHeaderOutputStreamTransform.init(metadataHeader:)),
+                    outputTrackingTransform,
+                ].compacted()),
+            ]
 
             let outputStream: BackupArchiveProtoOutputStream
             let fileUrl: URL
             switch genericStreamProvider.openOutputFileStream(
-                transforms: transforms,
+                transformStages: transformStages,
                 exportProgress: exportProgress,
             ) {
             case .success(let _outputStream, let _fileUrlProvider):
@@ -232,10 +238,19 @@ public class BackupArchiveEncryptedProtoStreamProvider {
 private class GenericStreamProvider {
     typealias ProtoStream = BackupArchive.ProtoStream
 
+    /// A group of transforms that run together, in order.
+    struct TransformStage {
+        let name: String
+        let transforms: [any StreamTransform]
+    }
+
     init() {}
 
+    /// - parameter transformStages: The transforms to apply to written frames.
+    ///     The first stage runs on the thread writing frames; each later stage
+    ///     runs on its own queue, taking data from the stage before it.
     func openOutputFileStream(
-        transforms: [any StreamTransform],
+        transformStages: [TransformStage],
         exportProgress: BackupArchiveExportProgress?,
     ) -> ProtoStream.OpenOutputStreamResult<URL> {
         let fileUrl = OWSFileSystem.temporaryFileUrl(
@@ -254,14 +269,32 @@ private class GenericStreamProvider {
             return .unableToOpenFileStream
         }
 
-        let transformingOutputStream = TransformingOutputStream(
-            transforms: transforms,
-            outputStream: outputStream,
-            runLoop: streamRunloop,
-        )
+        // Build the stages from the file backwards, so each can write to the next.
+        var transformedOutputStreams = [BackupArchiveProtoOutputStream.TransformedOutputStream]()
+        var nextOutputStream: OutputStreamable = outputStream
+        for (index, stage) in transformStages.enumerated().reversed() {
+            let isFirstStage = index == 0
+            let transformingOutputStream = TransformingOutputStream(
+                transforms: stage.transforms,
+                outputStream: nextOutputStream,
+                // Only the first stage is closed on this thread, so it's the
+                // one that unschedules the file stream from this run loop.
+                runLoop: isFirstStage ? streamRunloop : nil,
+            )
+            transformedOutputStreams.insert(.init(name: stage.name, stream: transformingOutputStream), at: 0)
+            if isFirstStage {
+                nextOutputStream = transformingOutputStream
+            } else {
+                nextOutputStream = PipelinedOutputStream(
+                    outputStream: transformingOutputStream,
+                    label: "org.signal.backup-export.\(stage.name.lowercased())",
+                )
+            }
+        }
 
         let backupOutputStream = BackupArchiveProtoOutputStream(
-            outputStream: transformingOutputStream,
+            outputStream: nextOutputStream,
+            transformedOutputStreams: transformedOutputStreams,
             exportProgress: exportProgress,
         )
 
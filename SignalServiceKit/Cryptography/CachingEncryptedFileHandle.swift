@@ -0,0 +1,175 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// An ``EncryptedFileHandle`` that keeps recently decrypted plaintext in a
+/// small cache of fixed-size pages.
+///
+/// Every seek on the underlying handle re-reads the preceding ciphertext block
+/// and sets up a new cipher context, and every read decrypts from scratch.
+/// Media playback, scrubbing in particular, issues many small reads at scattered
+/// offsets, often re-reading the same regions (e.g. container headers and
+/// indexes). This handle serves those from decrypted pages instead.
+///
+/// Pages are aligned to multiples of `pageSize` in the plaintext, and evicted
+/// least recently used first once there are `maxPageCount` of them. When a miss
+/// continues a sequential run, the following `readAheadPageCount` pages are
+/// decrypted with it, so the underlying handle is read in long contiguous runs
+/// without seeking.
+///
+/// Not thread safe; like other file handles, callers must serialize access.
+public final class CachingEncryptedFileHandle: EncryptedFileHandle {
+
+    public struct Stats: Equatable {
+        /// Pages that were needed by a read and were already cached.
+        public var hitCount: UInt64 = 0
+        /// Pages that were needed by a read and had to be decrypted.
+        public var missCount: UInt64 = 0
+        /// Pages decrypted ahead of being needed.
+        public var readAheadPageCount: UInt64 = 0
+        /// Pages dropped to stay within the page limit.
+        public var evictionCount: UInt64 = 0
+        /// Seeks performed on the underlying handle.
+        public var underlyingSeekCount: UInt64 = 0
+
+        public var hitRate: Double {
+            let lookupCount = hitCount + missCount
+            return lookupCount > 0 ? Double(hitCount) / Double(lookupCount) : 0
+        }
+    }
+
+    private struct Page {
+        let plaintext: Data
+        var lastAccess: UInt64
+    }
+
+    private let fileHandle: EncryptedFileHandle
+    private let pageSize: Int
+    private let maxPageCount: Int
+    private let readAheadPageCount: Int
+
+    private var pages = [UInt64: Page]()
+    /// Incremented on every page access, to order pages for eviction.
+    private var accessCounter: UInt64 = 0
+    /// The page just after the last one decrypted; a miss on this page
+    /// continues a sequential run.
+    private var nextSequentialPageIndex: UInt64 = 0
+    private var virtualOffset: UInt64 = 0
+
+    public private(set) var stats = Stats()
+
+    /// - parameter pageSize: Plaintext bytes per page. Must be a multiple of the
+    ///     AES block size.
+    /// - parameter maxPageCount: The most pages to hold at once.
+    /// - parameter readAheadPageCount: How many pages to decrypt past a
+    ///     sequential miss.
+    public init(
+        wrapping fileHandle: EncryptedFileHandle,
+        pageSize: Int = 64 * 1024,
+        maxPageCount: Int = 16,
+        readAheadPageCount: Int = 2,
+    ) {
+        owsPrecondition(pageSize > 0 && pageSize % Cryptography.Constants.aescbcBlockLength == 0)
+        owsPrecondition(maxPageCount > 0)
+        self.fileHandle = fileHandle
+        self.pageSize = pageSize
+        self.maxPageCount = maxPageCount
+        // Never read so far ahead that we evict the page being read.
+        self.readAheadPageCount = max(0, min(readAheadPageCount, maxPageCount - 1))
+        self.virtualOffset = fileHandle.offset()
+    }
+
+    // MARK: - EncryptedFileHandle
+
+    public var plaintextLength: UInt64 {
+        return fileHandle.plaintextLength
+    }
+
+    public func offset() -> UInt64 {
+        return virtualOffset
+    }
+
+    public func seek(toOffset: UInt64) throws {
+        guard toOffset <= plaintextLength else {
+            throw OWSAssertionError("Seeking past end of file")
+        }
+        // Seeking the underlying handle is deferred until we need to decrypt.
+        virtualOffset = toOffset
+    }
+
+    public func read(upToCount requestedByteCount: Int) throws -> Data {
+        guard requestedByteCount > 0, virtualOffset < plaintextLength else {
+            return Data()
+        }
+        let totalByteCount = Int(min(UInt64(requestedByteCount), plaintextLength - virtualOffset))
+
+        var output = Data(capacity: totalByteCount)
+        while output.count < totalByteCount {
+            let (pageIndex, offsetInPage) = virtualOffset.quotientAndRemainder(dividingBy: UInt64(pageSize))
+            let page = try plaintext(forPageAt: pageIndex)
+            let byteCount = min(totalByteCount - output.count, page.count - Int(offsetInPage))
+            guard byteCount > 0 else {
+                throw CryptographyError.decryptedLengthLessThanPlaintextLength
+            }
+            let start = page.startIndex + Int(offsetInPage)
+            output.append(page[start..<(start + byteCount)])
+            virtualOffset += UInt64(byteCount)
+        }
+        return output
+    }
+
+    // MARK: - Pages
+
+    private func plaintext(forPageAt pageIndex: UInt64) throws -> Data {
+        accessCounter += 1
+        if let page = pages[pageIndex] {
+            stats.hitCount += 1
+            pages[pageIndex]!.lastAccess = accessCounter
+            return page.plaintext
+        }
+        stats.missCount += 1
+
+        let isSequential = pageIndex == nextSequentialPageIndex
+        let pageCount = isSequential ? 1 + readAheadPageCount : 1
+
+        let pageOffset = pageIndex * UInt64(pageSize)
+        if fileHandle.offset() != pageOffset {
+            try fileHandle.seek(toOffset: pageOffset)
+            stats.underlyingSeekCount += 1
+        }
+
+        var requestedPage: Data?
+        for loadIndex in pageIndex..<(pageIndex + UInt64(pageCount)) {
+            let plaintext = try fileHandle.read(upToCount: pageSize)
+            if plaintext.isEmpty {
+                break
+            }
+            if loadIndex == pageIndex {
+                requestedPage = plaintext
+            } else {
+                stats.readAheadPageCount += 1
+            }
+            insert(Page(plaintext: plaintext, lastAccess: accessCounter), at: loadIndex)
+            nextSequentialPageIndex = loadIndex + 1
+        }
+        guard let requestedPage else {
+            throw CryptographyError.decryptedLengthLessThanPlaintextLength
+        }
+        return requestedPage
+    }
+
+    private func insert(_ page: Page, at pageIndex: UInt64) {
+        if pages.count >= maxPageCount, pages[pageIndex] == nil {
+            // There are only a handful of pages; a linear scan is cheaper
+            // than maintaining a linked list.
+            if let (leastRecentIndex, _) = pages.min(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+                pages.removeValue(forKey: leastRecentIndex)
+                stats.evictionCount += 1
+            }
+        }
+        pages[pageIndex] = page
+    }
+}
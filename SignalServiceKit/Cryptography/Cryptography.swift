@@ -13,7 +13,7 @@ public enum Cryptography {
     public static func computeSHA256DigestOfFile(at url: URL) throws -> Data {
         let file = try LocalFileHandle(url: url)
         var sha256 = SHA256()
-        var buffer = Data(count: Constants.diskPageSize)
+        var buffer = file.makeStreamingBuffer()
         var bytesRead: Int
         repeat {
             bytesRead = try file.read(into: &buffer)
@@ -159,6 +159,12 @@ public extension Cryptography {
         static let aescbcBlockLength = 16
         /// Optimize reads/writes by reading this many bytes at once; best balance of performance/memory use from testing in practice.
         static let diskPageSize = 8192
+        /// The block size for streaming a whole file through a cipher or
+        /// digest from start to finish. Much larger than `diskPageSize`, so
+        /// large attachments take a few hundred reads, cipher updates and
+        /// writes rather than tens of thousands, while keeping memory use
+        /// bounded at a couple of blocks.
+        static let streamingBlockSize = 1024 * 1024
     }
 
     static func paddedSize(unpaddedSize: UInt64) -> UInt64? {
@@ -260,7 +266,7 @@ public extension Cryptography {
 
         return try _encryptAttachment(
             enumerateInputInBlocks: { closure in
-                var buffer = Data(count: Constants.diskPageSize)
+                var buffer = inputFile.makeStreamingBuffer()
                 var totalBytesRead: UInt64 = 0
                 var bytesRead: Int
                 repeat {
@@ -315,7 +321,7 @@ public extension Cryptography {
                 var totalBytesRead: UInt64 = 0
                 var bytesRead: Int
                 repeat {
-                    let data = try encryptedFileHandle.read(upToCount: Constants.diskPageSize)
+                    let data = try encryptedFileHandle.read(upToCount: Constants.streamingBlockSize)
                     bytesRead = data.count
                     if bytesRead > 0 {
                         totalBytesRead += UInt64(bytesRead)
@@ -409,11 +415,22 @@ public extension Cryptography {
 
         let unpaddedPlaintextLength: UInt64
 
+        // Ciphertext for every block is written into this one buffer, which
+        // only grows if a block is bigger than any before it. Output blocks
+        // are slices of it, so as long as `output` doesn't hold onto them no
+        // ciphertext is allocated or copied per block.
+        var ciphertextBuffer = Data()
+
         // Encrypt the file by enumerating blocks. We want to keep our
         // memory footprint as small as possible during encryption.
         do {
             unpaddedPlaintextLength = try enumerateInputInBlocks { plaintextDataBlock in
-                let ciphertextBlock = try cipherContext.update(plaintextDataBlock)
+                let outputLength = cipherContext.outputLength(forUpdateWithInputLength: plaintextDataBlock.count)
+                if ciphertextBuffer.count < outputLength {
+                    ciphertextBuffer.count = outputLength
+                }
+                let ciphertextLength = try cipherContext.update(input: plaintextDataBlock, output: &ciphertextBuffer)
+                let ciphertextBlock = ciphertextBuffer.prefix(ciphertextLength)
 
                 hmac.update(data: ciphertextBlock)
                 sha256.update(data: ciphertextBlock)
@@ -421,12 +438,22 @@ public extension Cryptography {
             }
 
             // Add zero padding to the plaintext attachment data if necessary.
+            // Padding can be several MB for large files, so it's encrypted in
+            // blocks like the input.
             if applyExtraPadding {
                 let paddedPlaintextLength = paddedSize(unpaddedSize: unpaddedPlaintextLength)!
-                if paddedPlaintextLength > unpaddedPlaintextLength {
-                    let ciphertextBlock = try cipherContext.update(
-                        Data(repeating: 0, count: Int(paddedPlaintextLength - unpaddedPlaintextLength)),
-                    )
+                var remainingPaddingLength = paddedPlaintextLength > unpaddedPlaintextLength ? paddedPlaintextLength - unpaddedPlaintextLength : 0
+                let zeroBlock = Data(repeating: 0, count: Int(min(remainingPaddingLength, UInt64(Constants.streamingBlockSize))))
+                while remainingPaddingLength > 0 {
+                    let paddingBlock = zeroBlock.prefix(Int(min(remainingPaddingLength, UInt64(zeroBlock.count))))
+                    remainingPaddingLength -= UInt64(paddingBlock.count)
+
+                    let outputLength = cipherContext.outputLength(forUpdateWithInputLength: paddingBlock.count)
+                    if ciphertextBuffer.count < outputLength {
+                        ciphertextBuffer.count = outputLength
+                    }
+                    let ciphertextLength = try cipherContext.update(input: paddingBlock, output: &ciphertextBuffer)
+                    let ciphertextBlock = ciphertextBuffer.prefix(ciphertextLength)
 
                     hmac.update(data: ciphertextBlock)
                     sha256.update(data: ciphertextBlock)
@@ -504,6 +531,77 @@ public extension Cryptography {
         return validateFile(at: encryptedUrl, metadata: metadata)
     }
 
+    /// Decrypt an attachment and encrypt its plaintext again under a new key, in a single pass
+    /// and without writing the plaintext anywhere.
+    ///
+    /// The source's hmac and integrity check are validated as it is read; if either fails, or
+    /// anything else goes wrong, the partially written output file is deleted and this throws.
+    ///
+    /// - parameter encryptedUrl: The attachment file to re-encrypt.
+    /// - parameter metadata: The metadata needed to decrypt the source. Must have an integrityCheck.
+    /// - parameter encryptedOutputUrl: Where to write the re-encrypted output, which is padded like
+    ///     ``encryptAttachment(at:output:attachmentKey:)``.
+    /// - parameter attachmentKey: The key for encrypting the output. A
+    /// random key will be generated if none is provided.
+    internal static func reencryptAttachment(
+        at encryptedUrl: URL,
+        metadata: DecryptionMetadata,
+        output encryptedOutputUrl: URL,
+        attachmentKey inputKey: AttachmentKey? = nil,
+    ) throws -> EncryptionMetadata {
+        // We require integrityChecks for all attachments.
+        guard let integrityCheck = metadata.integrityCheck, !integrityCheck.isEmpty else {
+            throw OWSAssertionError("Missing integrityCheck")
+        }
+
+        guard
+            FileManager.default.createFile(
+                atPath: encryptedOutputUrl.path,
+                contents: nil,
+                attributes: [.protectionKey: FileProtectionType.completeUntilFirstUserAuthentication],
+            )
+        else {
+            throw OWSAssertionError("Cannot access output file.")
+        }
+        let outputFile = try FileHandle(forWritingTo: encryptedOutputUrl)
+
+        let inputKey = inputKey ?? .generate()
+
+        do {
+            let encryptionMetadata = try _encryptAttachment(
+                enumerateInputInBlocks: { closure in
+                    var totalBytesRead: UInt64 = 0
+                    try decryptFile(
+                        at: encryptedUrl,
+                        metadata: metadata,
+                        outputBlockSize: Constants.streamingBlockSize,
+                    ) { plaintextDataBlock in
+                        totalBytesRead += UInt64(plaintextDataBlock.count)
+                        try closure(plaintextDataBlock)
+                    }
+                    return totalBytesRead
+                },
+                output: { outputBlock in
+                    outputFile.write(outputBlock)
+                },
+                attachmentKey: inputKey,
+                applyExtraPadding: true,
+            )
+            outputFile.closeFile()
+            return encryptionMetadata
+        } catch let error {
+            // In the event of any failure, we both throw *and*
+            // delete the partially re-encrypted output file.
+            outputFile.closeFile()
+            do {
+                try FileManager.default.removeItem(at: encryptedOutputUrl)
+            } catch let fileDeletionError {
+                Logger.error("Failed to clean up file after cryptography failure: \(fileDeletionError)")
+            }
+            throw error
+        }
+    }
+
     internal static func encryptedAttachmentFileHandle(
         at encryptedUrl: URL,
         plaintextLength: UInt64,
@@ -658,7 +756,7 @@ public extension Cryptography {
         metadata: DecryptionMetadata,
         validateHmacAndIntegrityCheck: Bool = true,
         outputBlockSize: Int? = 1024 * 16,
-        output: (_ plaintextDataBlock: Data) -> Void,
+        output: (_ plaintextDataBlock: Data) throws -> Void,
     ) throws {
         let paddingStrategy: PaddingDecryptionStrategy
         if let plaintextLength = metadata.plaintextLength {
@@ -713,7 +811,7 @@ public extension Cryptography {
             if plaintextDataBlock.isEmpty {
                 gotEmptyBlock = true
             } else {
-                output(plaintextDataBlock)
+                try output(plaintextDataBlock)
                 totalPlaintextLength += plaintextDataBlock.count
                 plaintextHasher?.update(data: plaintextDataBlock)
             }
@@ -1191,6 +1289,14 @@ private struct LocalFileHandle: ~Copyable {
         try buffer.withUnsafeMutableBytes { try fileDescriptor.read(into: $0) }
     }
 
+    /// A buffer for reading the file from start to finish in blocks of
+    /// ``Cryptography/Constants/streamingBlockSize``, or smaller if the whole
+    /// file fits in less.
+    func makeStreamingBuffer() -> Data {
+        let blockSize = min(UInt64(Cryptography.Constants.streamingBlockSize), max(fileLength, 1))
+        return Data(count: Int(blockSize))
+    }
+
     /// Convenience wrapper around ``read(into:maxLength:)`` that returns the output
     /// as bytes and assumes any failure to read the requested number of bytes is an error.
     ///
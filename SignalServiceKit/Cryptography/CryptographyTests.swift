@@ -433,6 +433,264 @@ class CryptographyTestsSwift: XCTestCase {
         decryptedData = try encryptedFileHandle.read(upToCount: plaintextData4.count)
         XCTAssertEqual(plaintextData4, decryptedData)
     }
+
+    func test_attachmentEncryptionAndDecryptionAcrossStreamingBlocks() throws {
+        let blockSize = Cryptography.Constants.streamingBlockSize
+        let plaintextLengths: [Int] = [
+            blockSize - 1,
+            blockSize,
+            blockSize + 1,
+            2 * blockSize + 17,
+        ]
+        for plaintextLength in plaintextLengths {
+            let temporaryDirectory = URL(fileURLWithPath: NSTemporaryDirectory(), isDirectory: true)
+            let plaintextFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+            let encryptedFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+
+            let plaintextData = Randomness.generateRandomBytes(UInt(plaintextLength))
+            try plaintextData.write(to: plaintextFile)
+            let encryptionMetadata = try Cryptography.encryptAttachment(at: plaintextFile, output: encryptedFile)
+
+            XCTAssertEqual(try OWSFileSystem.fileSize(of: encryptedFile), encryptionMetadata.encryptedLength)
+            XCTAssertEqual(try Cryptography.computeSHA256DigestOfFile(at: encryptedFile), encryptionMetadata.digest)
+
+            try FileManager.default.removeItem(at: plaintextFile)
+            let decryptedData = try Cryptography.decryptAttachment(
+                at: encryptedFile,
+                metadata: .init(
+                    key: encryptionMetadata.key,
+                    integrityCheck: .ciphertextDigest(encryptionMetadata.digest),
+                    plaintextLength: UInt64(plaintextLength),
+                ),
+            )
+
+            XCTAssertEqual(plaintextData, decryptedData)
+            try FileManager.default.removeItem(at: encryptedFile)
+        }
+    }
+
+    func test_attachmentReencryption() throws {
+        let temporaryDirectory = URL(fileURLWithPath: NSTemporaryDirectory(), isDirectory: true)
+        let plaintextLength = Cryptography.Constants.streamingBlockSize + 17
+        let plaintextData = Randomness.generateRandomBytes(UInt(plaintextLength))
+        let encryptedFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        let reencryptedFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer {
+            try? FileManager.default.removeItem(at: encryptedFile)
+            try? FileManager.default.removeItem(at: reencryptedFile)
+        }
+
+        let (encryptedData, encryptionMetadata) = try Cryptography.encrypt(plaintextData, applyExtraPadding: true)
+        try encryptedData.write(to: encryptedFile)
+
+        let reencryptionMetadata = try Cryptography.reencryptAttachment(
+            at: encryptedFile,
+            metadata: .init(
+                key: encryptionMetadata.key,
+                integrityCheck: .plaintextHash(Data(SHA256.hash(data: plaintextData))),
+                plaintextLength: UInt64(plaintextLength),
+            ),
+            output: reencryptedFile,
+        )
+
+        XCTAssertNotEqual(reencryptionMetadata.key.combinedKey, encryptionMetadata.key.combinedKey)
+        XCTAssertEqual(reencryptionMetadata.plaintextLength, UInt64(plaintextLength))
+        XCTAssertEqual(try OWSFileSystem.fileSize(of: reencryptedFile), reencryptionMetadata.encryptedLength)
+        XCTAssertEqual(try Cryptography.computeSHA256DigestOfFile(at: reencryptedFile), reencryptionMetadata.digest)
+
+        let decryptedData = try Cryptography.decryptAttachment(
+            at: reencryptedFile,
+            metadata: .init(
+                key: reencryptionMetadata.key,
+                integrityCheck: .ciphertextDigest(reencryptionMetadata.digest),
+                plaintextLength: UInt64(plaintextLength),
+            ),
+        )
+        XCTAssertEqual(plaintextData, decryptedData)
+    }
+
+    func test_attachmentReencryptionWithBadPlaintextHash() throws {
+        let temporaryDirectory = URL(fileURLWithPath: NSTemporaryDirectory(), isDirectory: true)
+        let plaintextData = Randomness.generateRandomBytes(1000)
+        let encryptedFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        let reencryptedFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer {
+            try? FileManager.default.removeItem(at: encryptedFile)
+        }
+
+        let (encryptedData, encryptionMetadata) = try Cryptography.encrypt(plaintextData, applyExtraPadding: true)
+        try encryptedData.write(to: encryptedFile)
+
+        XCTAssertThrowsError(try Cryptography.reencryptAttachment(
+            at: encryptedFile,
+            metadata: .init(
+                key: encryptionMetadata.key,
+                integrityCheck: .plaintextHash(Randomness.generateRandomBytes(32)),
+                plaintextLength: UInt64(plaintextData.count),
+            ),
+            output: reencryptedFile,
+        ))
+        // The partially re-encrypted output must not be left behind.
+        XCTAssertFalse(FileManager.default.fileExists(atPath: reencryptedFile.path))
+    }
+
+    /// Logs encryption and digest throughput in MB/s for a few file sizes.
+    func test_fileEncryptionThroughput() throws {
+        let temporaryDirectory = URL(fileURLWithPath: NSTemporaryDirectory(), isDirectory: true)
+        let megabyte = 1024 * 1024
+        for fileSize in [megabyte, 8 * megabyte, 32 * megabyte] {
+            let plaintextFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+            let encryptedFile = temporaryDirectory.appendingPathComponent(UUID().uuidString)
+            defer {
+                try? FileManager.default.removeItem(at: plaintextFile)
+                try? FileManager.default.removeItem(at: encryptedFile)
+            }
+            try Randomness.generateRandomBytes(UInt(fileSize)).write(to: plaintextFile)
+
+            func megabytesPerSecond(_ block: () throws -> Void) rethrows -> Double {
+                let startDate = MonotonicDate()
+                try block()
+                let durationNanos = max((MonotonicDate() - startDate).nanoseconds, 1)
+                return Double(fileSize) / Double(megabyte) / (Double(durationNanos) / Double(NSEC_PER_SEC))
+            }
+
+            let encryptSpeed = try megabytesPerSecond {
+                _ = try Cryptography.encryptAttachment(at: plaintextFile, output: encryptedFile)
+            }
+            let digestSpeed = try megabytesPerSecond {
+                _ = try Cryptography.computeSHA256DigestOfFile(at: plaintextFile)
+            }
+            Logger.info("\(fileSize / megabyte)MB: encrypt \(String(format: "%.1f", encryptSpeed))MB/s, digest \(String(format: "%.1f", digestSpeed))MB/s")
+        }
+    }
+
+    private func makeEncryptedAttachmentFileHandle(plaintextData: Data) throws -> (EncryptedFileHandle, URL) {
+        let encryptedFile = URL(fileURLWithPath: NSTemporaryDirectory(), isDirectory: true).appendingPathComponent(UUID().uuidString)
+        let (encryptedData, metadata) = try Cryptography.encrypt(plaintextData, applyExtraPadding: true)
+        try encryptedData.write(to: encryptedFile)
+        let fileHandle = try Cryptography.encryptedAttachmentFileHandle(
+            at: encryptedFile,
+            plaintextLength: UInt64(plaintextData.count),
+            attachmentKey: metadata.key,
+        )
+        return (fileHandle, encryptedFile)
+    }
+
+    func test_cachingEncryptedFileHandleRandomReads() throws {
+        let plaintextData = Randomness.generateRandomBytes(300_000)
+        let (fileHandle, encryptedFile) = try makeEncryptedAttachmentFileHandle(plaintextData: plaintextData)
+        defer { try? FileManager.default.removeItem(at: encryptedFile) }
+
+        // Small pages and few of them so reads span pages and evict.
+        let cachingFileHandle = CachingEncryptedFileHandle(wrapping: fileHandle, pageSize: 4096, maxPageCount: 4)
+        XCTAssertEqual(cachingFileHandle.plaintextLength, UInt64(plaintextData.count))
+
+        var generator = SystemRandomNumberGenerator()
+        for _ in 0..<500 {
+            let offset = Int.random(in: 0...plaintextData.count, using: &generator)
+            let length = Int.random(in: 0...20_000, using: &generator)
+            try cachingFileHandle.seek(toOffset: UInt64(offset))
+            let expected = plaintextData[offset..<min(offset + length, plaintextData.count)]
+            XCTAssertEqual(try cachingFileHandle.read(upToCount: length), expected)
+            XCTAssertEqual(cachingFileHandle.offset(), UInt64(offset + expected.count))
+        }
+
+        try cachingFileHandle.seek(toOffset: UInt64(plaintextData.count))
+        XCTAssertEqual(try cachingFileHandle.read(upToCount: 10), Data())
+        XCTAssertThrowsError(try cachingFileHandle.seek(toOffset: UInt64(plaintextData.count + 1)))
+    }
+
+    func test_cachingEncryptedFileHandleStats() throws {
+        let pageSize = 4096
+        let plaintextData = Randomness.generateRandomBytes(UInt(pageSize * 10))
+        let (fileHandle, encryptedFile) = try makeEncryptedAttachmentFileHandle(plaintextData: plaintextData)
+        defer { try? FileManager.default.removeItem(at: encryptedFile) }
+
+        let cachingFileHandle = CachingEncryptedFileHandle(
+            wrapping: fileHandle,
+            pageSize: pageSize,
+            maxPageCount: 4,
+            readAheadPageCount: 2,
+        )
+
+        // Reading from the start is sequential, so pages 1 and 2 are read ahead.
+        _ = try cachingFileHandle.read(upToCount: 100)
+        XCTAssertEqual(cachingFileHandle.stats.missCount, 1)
+        XCTAssertEqual(cachingFileHandle.stats.readAheadPageCount, 2)
+
+        // Pages 0-2 are now cached.
+        _ = try cachingFileHandle.read(upToCount: pageSize * 3 - 100)
+        XCTAssertEqual(cachingFileHandle.stats.missCount, 1)
+        XCTAssertEqual(cachingFileHandle.stats.hitCount, 3)
+        XCTAssertEqual(cachingFileHandle.stats.underlyingSeekCount, 0)
+
+        // A jump isn't sequential, so only its own page is decrypted.
+        try cachingFileHandle.seek(toOffset: UInt64(pageSize * 8))
+        _ = try cachingFileHandle.read(upToCount: 100)
+        XCTAssertEqual(cachingFileHandle.stats.missCount, 2)
+        XCTAssertEqual(cachingFileHandle.stats.readAheadPageCount, 2)
+        XCTAssertEqual(cachingFileHandle.stats.underlyingSeekCount, 1)
+        XCTAssertEqual(cachingFileHandle.stats.evictionCount, 0)
+
+        try cachingFileHandle.seek(toOffset: 0)
+        _ = try cachingFileHandle.read(upToCount: 100)
+        XCTAssertEqual(cachingFileHandle.stats.hitCount, 4)
+
+        // The cache is full; page 1 is now the least recently used.
+        try cachingFileHandle.seek(toOffset: UInt64(pageSize * 5))
+        _ = try cachingFileHandle.read(upToCount: 100)
+        XCTAssertEqual(cachingFileHandle.stats.missCount, 3)
+        XCTAssertEqual(cachingFileHandle.stats.evictionCount, 1)
+        XCTAssertEqual(cachingFileHandle.stats.hitRate, 4.0 / 7.0)
+    }
+
+    /// Replays the data requests AVFoundation made while a ~6MB video was
+    /// opened, played for a few seconds and scrubbed back and forth, and logs
+    /// how long they take with and without the page cache.
+    func test_cachingEncryptedFileHandleScrubbingPerformance() throws {
+        let plaintextLength = 6_291_456
+        // (offset, length) of each AVAssetResourceLoadingDataRequest.
+        let dataRequests: [(Int, Int)] = [
+            (0, 2), (0, 65_536), (6_225_920, 65_536), (6_160_384, 131_072),
+            (0, 65_536), (32, 262_144), (262_176, 262_144), (524_320, 524_288),
+            (6_225_920, 65_536), (3_145_728, 262_144), (3_014_656, 131_072), (3_145_728, 262_144),
+            (6_225_920, 65_536), (1_572_864, 262_144), (1_507_328, 131_072), (1_572_864, 524_288),
+            (4_718_592, 262_144), (4_653_056, 65_536), (4_718_592, 262_144), (6_225_920, 65_536),
+            (2_097_152, 262_144), (1_966_080, 131_072), (2_097_152, 131_072), (2_228_224, 262_144),
+            (5_505_024, 262_144), (5_439_488, 65_536), (5_505_024, 131_072), (6_225_920, 65_536),
+            (32, 262_144), (262_176, 262_144), (524_320, 524_288), (1_048_608, 524_288),
+        ]
+        // The resource loader services each request in 4KB reads.
+        let readSize = 4096
+
+        let plaintextData = Randomness.generateRandomBytes(UInt(plaintextLength))
+        let (fileHandle, encryptedFile) = try makeEncryptedAttachmentFileHandle(plaintextData: plaintextData)
+        defer { try? FileManager.default.removeItem(at: encryptedFile) }
+
+        func replay(_ fileHandle: EncryptedFileHandle) throws -> UInt64 {
+            let startDate = MonotonicDate()
+            for (offset, length) in dataRequests {
+                if fileHandle.offset() != UInt64(offset) {
+                    try fileHandle.seek(toOffset: UInt64(offset))
+                }
+                var bytesRead = 0
+                while bytesRead < length {
+                    let data = try fileHandle.read(upToCount: min(readSize, length - bytesRead))
+                    XCTAssertEqual(data, plaintextData[(offset + bytesRead)..<(offset + bytesRead + data.count)])
+                    bytesRead += data.count
+                }
+            }
+            return (MonotonicDate() - startDate).nanoseconds
+        }
+
+        let cachingFileHandle = CachingEncryptedFileHandle(wrapping: fileHandle)
+        let uncachedNanos = try replay(fileHandle)
+        let cachedNanos = try replay(cachingFileHandle)
+
+        let stats = cachingFileHandle.stats
+        Logger.info("Scrubbing replay: uncached \(uncachedNanos / NSEC_PER_USEC)us, cached \(cachedNanos / NSEC_PER_USEC)us, hit rate \(String(format: "%.2f", stats.hitRate)), \(stats.missCount) misses, \(stats.readAheadPageCount) read ahead, \(stats.evictionCount) evicted")
+        XCTAssertGreaterThan(stats.hitRate, 0.5)
+    }
 }
 
 struct CryptographyTest2 {
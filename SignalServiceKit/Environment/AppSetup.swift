@@ -227,6 +227,7 @@ extension AppSetup.GlobalsContinuation {
             appVersion: appVersion.currentAppVersion4,
             db: databaseStorage,
         )
+        let maintenanceScheduler = MaintenanceScheduler(db: databaseStorage)
 
         let recipientDatabaseTable = RecipientDatabaseTable()
         let signalAccountStore = SignalAccountStoreImpl()
@@ -296,7 +297,7 @@ extension AppSetup.GlobalsContinuation {
 
         let groupSendEndorsementStore = GroupSendEndorsementStore()
 
-        let messageSenderJobQueue = MessageSenderJobQueue(appReadiness: appReadiness)
+        let messageSenderJobQueue = MessageSenderJobQueue(appReadiness: appReadiness, db: db)
         let modelReadCaches = ModelReadCaches(
             factory: ModelReadCacheFactory(appReadiness: appReadiness),
         )
@@ -575,7 +576,12 @@ extension AppSetup.GlobalsContinuation {
 
         let orphanedAttachmentStore = OrphanedAttachmentStore()
         let attachmentUploadStore = AttachmentUploadStore()
-        let attachmentDownloadStore = AttachmentDownloadStore(dateProvider: dateProvider)
+        let attachmentDownloadStore = AttachmentDownloadStore(
+            dateProvider: dateProvider,
+            // Only the main app is told about writes from other processes, so
+            // only it can keep the index up to date.
+            queueIndex: appContext.isMainApp ? AttachmentDownloadQueueIndex(db: db) : nil,
+        )
 
         let orphanedBackupAttachmentStore = OrphanedBackupAttachmentStore()
         let orphanedBackupAttachmentScheduler = OrphanedBackupAttachmentSchedulerImpl(
@@ -890,6 +896,7 @@ extension AppSetup.GlobalsContinuation {
             dateProvider: dateProvider,
             db: db,
             interactionDeleteManager: interactionDeleteManager,
+            maintenanceScheduler: maintenanceScheduler,
             messageTimestampGenerator: .sharedInstance,
             notificationPresenter: notificationPresenter,
         )
@@ -1211,7 +1218,11 @@ extension AppSetup.GlobalsContinuation {
 
         let messageSenderImpl = MessageSenderImpl(
             accountChecker: accountChecker,
-            groupSendEndorsementStore: groupSendEndorsementStore,
+            db: db,
+            groupSendEndorsementCache: GroupSendEndorsementCache(
+                groupSendEndorsementStore: groupSendEndorsementStore,
+                recipientDatabaseTable: recipientDatabaseTable,
+            ),
             senderKeySendingManager: senderKeySendingManager,
         )
         let messageSender = testDependencies.messageSender ?? messageSenderImpl
@@ -1870,6 +1881,7 @@ extension AppSetup.GlobalsContinuation {
             localFileBackupManager: localFileBackupManager,
             localProfileChecker: localProfileChecker,
             localUsernameManager: localUsernameManager,
+            maintenanceScheduler: maintenanceScheduler,
             mediaBandwidthPreferenceStore: mediaBandwidthPreferenceStore,
             messageSender: messageSender,
             messageStickerManager: messageStickerManager,
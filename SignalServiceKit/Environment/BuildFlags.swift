@@ -99,6 +99,16 @@ public enum BuildFlags {
     }
 
     static let hardDeleteGroupThreads = true
+
+    // Builds from before compact group memberships can't decode them, and
+    // would show groups as having no members after a downgrade. Turn this on
+    // in a release after the first one that decodes them.
+    static let writeCompactGroupMemberships = false
+
+    // Builds from before compact audio waveforms can't decode them, and would
+    // fail to show waveforms after a downgrade. Turn this on in a release
+    // after the first one that decodes them.
+    static let writeCompactAudioWaveforms = false
 }
 
 // MARK: -
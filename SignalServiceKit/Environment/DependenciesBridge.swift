@@ -143,6 +143,7 @@ public class DependenciesBridge {
     public let localFileBackupExportJobRunner: LocalFileBackupExportJobRunner
     public let localFileBackupManager: LocalFileBackupManager
     public let localUsernameManager: LocalUsernameManager
+    public let maintenanceScheduler: MaintenanceScheduler
     public let mediaBandwidthPreferenceStore: MediaBandwidthPreferenceStore
     public let messageSender: any MessageSender
     public let messageStickerManager: MessageStickerManager
@@ -294,6 +295,7 @@ public class DependenciesBridge {
         localFileBackupManager: LocalFileBackupManager,
         localProfileChecker: LocalProfileChecker,
         localUsernameManager: LocalUsernameManager,
+        maintenanceScheduler: MaintenanceScheduler,
         mediaBandwidthPreferenceStore: MediaBandwidthPreferenceStore,
         messageSender: any MessageSender,
         messageStickerManager: MessageStickerManager,
@@ -443,6 +445,7 @@ public class DependenciesBridge {
         self.localFileBackupManager = localFileBackupManager
         self.localProfileChecker = localProfileChecker
         self.localUsernameManager = localUsernameManager
+        self.maintenanceScheduler = maintenanceScheduler
         self.mediaBandwidthPreferenceStore = mediaBandwidthPreferenceStore
         self.messageSender = messageSender
         self.messageStickerManager = messageStickerManager
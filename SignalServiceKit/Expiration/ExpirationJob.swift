@@ -16,6 +16,7 @@ import UIKit
 open class ExpirationJob<ExpiringElement> {
     private let dateProvider: DateProvider
     private let db: DB
+    private let maintenanceScheduler: MaintenanceScheduler?
     private let minIntervalBetweenDeletes: TimeInterval
 
     public let logger: PrefixedLogger
@@ -32,10 +33,12 @@ open class ExpirationJob<ExpiringElement> {
         dateProvider: @escaping DateProvider,
         db: DB,
         logger: PrefixedLogger,
+        maintenanceScheduler: MaintenanceScheduler? = nil,
         minIntervalBetweenDeletes: TimeInterval = 1,
     ) {
         self.dateProvider = dateProvider
         self.db = db
+        self.maintenanceScheduler = maintenanceScheduler
         self.logger = logger
         self.minIntervalBetweenDeletes = minIntervalBetweenDeletes
     }
@@ -141,17 +144,34 @@ open class ExpirationJob<ExpiringElement> {
             }
         }
         try Task.checkCancellation()
-        return try await TimeGatedBatch.processAll(db: db) { tx throws -> TimeGatedBatch.ProcessBatchResult<Date?> in
+        let deleteNextExpiredElement = { (tx: DBWriteTransaction) throws -> TimeGatedBatch.ProcessBatchResult<Date?> in
             try Task.checkCancellation()
-            let element = nextExpiringElement(tx: tx)
-            if let element, dateProvider() >= expirationDate(ofElement: element) {
+            let element = self.nextExpiringElement(tx: tx)
+            if let element, self.dateProvider() >= self.expirationDate(ofElement: element) {
                 // Expired element: delete it and keep iterating.
-                deleteExpiredElement(element, tx: tx)
+                self.deleteExpiredElement(element, tx: tx)
                 deletedCount += 1
                 return .more
             }
             // Nothing expired to delete: stop iterating.
-            return .done(element.map(expirationDate(ofElement:)))
+            return .done(element.map(self.expirationDate(ofElement:)))
         }
+
+        guard let maintenanceScheduler else {
+            return try await TimeGatedBatch.processAll(db: db, processBatch: deleteNextExpiredElement)
+        }
+        // Bursts of expired elements (eg, after being offline for a while) are
+        // deleted in shorter transactions, and their cost is recorded.
+        var nextExpirationDate: Date?
+        try await maintenanceScheduler.runUntilDone(name: logger.prefix) { tx throws -> MaintenanceScheduler.StepResult in
+            switch try deleteNextExpiredElement(tx) {
+            case .more:
+                return .more
+            case .done(let expirationDate):
+                nextExpirationDate = expirationDate
+                return .done
+            }
+        }
+        return nextExpirationDate
     }
 }
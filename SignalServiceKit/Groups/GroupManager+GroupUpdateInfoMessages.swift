@@ -35,6 +35,8 @@ extension GroupManager {
     /// - Parameter newlyLearnedPniToAciAssociations
     /// Associations between PNIs and ACIs that were learned as a result of this
     /// group update.
+    /// - Parameter changedMemberServiceIds
+    /// If known, the only members whose state may differ between the models.
     public static func insertGroupUpdateInfoMessage(
         groupThread: TSGroupThread,
         oldGroupModel: TSGroupModel,
@@ -42,6 +44,7 @@ extension GroupManager {
         oldDisappearingMessageToken: DisappearingMessageToken,
         newDisappearingMessageToken: DisappearingMessageToken,
         newlyLearnedPniToAciAssociations: [Pni: Aci],
+        changedMemberServiceIds: Set<ServiceId>? = nil,
         groupUpdateSource: GroupUpdateSource,
         localIdentifiers: LocalIdentifiers,
         spamReportingMetadata: GroupUpdateSpamReportingMetadata,
@@ -56,6 +59,7 @@ extension GroupManager {
             oldDisappearingMessageToken: oldDisappearingMessageToken,
             newDisappearingMessageToken: newDisappearingMessageToken,
             newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
+            changedMemberServiceIds: changedMemberServiceIds,
             groupUpdateSource: groupUpdateSource,
             transaction: transaction,
         )
@@ -959,11 +959,16 @@ public class GroupManager: NSObject {
     /// - Parameter newlyLearnedPniToAciAssociations
     /// Associations between PNIs and ACIs that were learned as a result of this
     /// group update.
+    /// - Parameter changedMemberServiceIds
+    /// If known (e.g., from applying change actions), the only members whose
+    /// state may differ between the current and new models. Only they are
+    /// compared when working out what changed.
     public static func updateExistingGroupThreadInDatabaseAndCreateInfoMessage(
         groupThread: TSGroupThread,
         newGroupModel: TSGroupModel,
         newDisappearingMessageToken: DisappearingMessageToken?,
         newlyLearnedPniToAciAssociations: [Pni: Aci],
+        changedMemberServiceIds: Set<ServiceId>? = nil,
         groupUpdateSource: GroupUpdateSource,
         infoMessagePolicy: InfoMessagePolicy = .insert,
         localIdentifiers: LocalIdentifiers,
@@ -999,16 +1004,17 @@ public class GroupManager: NSObject {
             )
         }
 
-        do {
-            let oldMembers = oldGroupModel.membership.allMembersOfAnyKindServiceIds
-            let newMembers = newGroupModel.membership.allMembersOfAnyKindServiceIds
+        let (addedMembers, removedMembers) = addedAndRemovedMembers(
+            oldGroupMembership: oldGroupModel.membership,
+            newGroupMembership: newGroupModel.membership,
+            changedMemberServiceIds: changedMemberServiceIds,
+        )
 
-            insertRecipients(
-                addedMembers: newMembers.subtracting(oldMembers),
-                localIdentifiers: localIdentifiers,
-                tx: transaction,
-            )
-        }
+        insertRecipients(
+            addedMembers: addedMembers,
+            localIdentifiers: localIdentifiers,
+            tx: transaction,
+        )
 
         // Step 3: If any member was removed, make sure we rotate our sender key
         // session.
@@ -1018,10 +1024,8 @@ public class GroupManager: NSObject {
         // this was our only mutual group with them.
         do {
             let oldMembers = oldGroupModel.membership.allMembersOfAnyKindServiceIds
-            let newMembers = newGroupModel.membership.allMembersOfAnyKindServiceIds
 
             // If somebody else was removed, reset the sender key session.
-            let removedMembers = oldMembers.subtracting(newMembers)
             if !removedMembers.subtracting([localIdentifiers.aci]).isEmpty {
                 let senderKeySendingManager = DependenciesBridge.shared.senderKeySendingManager
                 senderKeySendingManager.deleteSenderKey(
@@ -1104,12 +1108,13 @@ public class GroupManager: NSObject {
         )
 
         let showInfoMessageForChange: Bool = (
-            newGroupModel.showInfoMessageForChangeComparedTo(to: oldGroupModel)
+            newGroupModel.showInfoMessageForChangeComparedTo(to: oldGroupModel, changedMemberServiceIds: changedMemberServiceIds)
                 || updateDMResult.newConfiguration.asVersionedToken != updateDMResult.oldConfiguration.asVersionedToken,
         )
 
         groupThread.update(
             with: newGroupModel,
+            changedMemberServiceIds: changedMemberServiceIds,
             transaction: transaction,
         )
 
@@ -1135,6 +1140,7 @@ public class GroupManager: NSObject {
                 oldDisappearingMessageToken: updateDMResult.oldConfiguration.asToken,
                 newDisappearingMessageToken: updateDMResult.newConfiguration.asToken,
                 newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
+                changedMemberServiceIds: changedMemberServiceIds,
                 groupUpdateSource: groupUpdateSource,
                 localIdentifiers: localIdentifiers,
                 spamReportingMetadata: spamReportingMetadata,
@@ -1143,6 +1149,34 @@ public class GroupManager: NSObject {
         }
     }
 
+    /// The members of any kind in `newGroupMembership` but not
+    /// `oldGroupMembership`, and vice versa.
+    private static func addedAndRemovedMembers(
+        oldGroupMembership: GroupMembership,
+        newGroupMembership: GroupMembership,
+        changedMemberServiceIds: Set<ServiceId>?,
+    ) -> (added: Set<ServiceId>, removed: Set<ServiceId>) {
+        guard let changedMemberServiceIds else {
+            let oldMembers = oldGroupMembership.allMembersOfAnyKindServiceIds
+            let newMembers = newGroupMembership.allMembersOfAnyKindServiceIds
+            return (newMembers.subtracting(oldMembers), oldMembers.subtracting(newMembers))
+        }
+
+        var addedMembers = Set<ServiceId>()
+        var removedMembers = Set<ServiceId>()
+        for serviceId in changedMemberServiceIds {
+            switch (oldGroupMembership.isMemberOfAnyKind(serviceId), newGroupMembership.isMemberOfAnyKind(serviceId)) {
+            case (false, true):
+                addedMembers.insert(serviceId)
+            case (true, false):
+                removedMembers.insert(serviceId)
+            case (false, false), (true, true):
+                break
+            }
+        }
+        return (addedMembers, removedMembers)
+    }
+
     private static func mutualGroupThreads(
         with member: ServiceId,
         localAci: Aci,
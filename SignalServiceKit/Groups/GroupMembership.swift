@@ -145,7 +145,10 @@ public class GroupMembership: NSObject, NSSecureCoding {
 
     // MARK: Init
 
-    fileprivate var memberStates: MemberStateMap
+    fileprivate let memberStates: MemberStateMap
+    /// Views of `memberStates` built once, since groups rarely change but
+    /// are queried often and can have a thousand members.
+    private let partitions: Partitions
     public fileprivate(set) var bannedMembers: BannedMembersMap
     private var invalidInviteMap: InvalidInviteMap
     private var memberLabels: MemberLabelsMap
@@ -157,6 +160,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
     @objc
     override public init() {
         self.memberStates = [:]
+        self.partitions = Partitions(memberStates: [:])
         self.bannedMembers = [:]
         self.invalidInviteMap = [:]
         self.memberLabels = [:]
@@ -168,16 +172,35 @@ public class GroupMembership: NSObject, NSSecureCoding {
 
     @objc
     public required init?(coder: NSCoder) {
+        if let compactData = coder.decodeObject(of: NSData.self, forKey: Self.compactContentsKey) as Data? {
+            let contents: CompactMembershipCoding.Contents
+            do {
+                contents = try CompactMembershipCoding.decode(compactData)
+            } catch {
+                owsFailDebug("Could not decode compact membership: \(error)")
+                return nil
+            }
+            self.memberStates = contents.memberStates
+            self.partitions = Partitions(memberStates: contents.memberStates)
+            self.bannedMembers = contents.bannedMembers
+            self.invalidInviteMap = contents.invalidInviteMap
+            self.memberLabels = contents.memberLabels
+
+            super.init()
+            return
+        }
+
         self.invalidInviteMap = coder.decodeDictionary(
             withKeyClass: NSData.self,
             objectClass: InvalidInviteModel.self,
             forKey: Self.invalidInviteMapKey,
         ) as [Data: InvalidInviteModel]? ?? [:]
 
+        let memberStates: MemberStateMap
         if let memberStatesData = coder.decodeObject(of: NSData.self, forKey: Self.memberStatesKey) as Data? {
             let decoder = JSONDecoder()
             do {
-                self.memberStates = try decoder.decode(MemberStateMap.self, from: memberStatesData)
+                memberStates = try decoder.decode(MemberStateMap.self, from: memberStatesData)
             } catch {
                 owsFailDebug("Could not decode member states: \(error)")
                 return nil
@@ -189,11 +212,13 @@ public class GroupMembership: NSObject, NSSecureCoding {
                 forKey: Self.legacyMemberStatesKey,
             ) as LegacyMemberStateMap?
         {
-            self.memberStates = Self.convertLegacyMemberStateMap(legacyMemberStateMap)
+            memberStates = Self.convertLegacyMemberStateMap(legacyMemberStateMap)
         } else {
             owsFailDebug("Could not decode legacy member states.")
             return nil
         }
+        self.memberStates = memberStates
+        self.partitions = Partitions(memberStates: memberStates)
 
         if
             let bannedMembers = coder.decodeDictionary(
@@ -226,6 +251,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
         super.init()
     }
 
+    private static var compactContentsKey: String { "compactContents" }
     private static var memberStatesKey: String { "memberStates" }
     private static var legacyMemberStatesKey: String { "memberStateMap" }
     private static var bannedMembersKey: String { "bannedMembers" }
@@ -233,6 +259,32 @@ public class GroupMembership: NSObject, NSSecureCoding {
     private static var memberLabelsMapKey: String { "memberLabelsMapV3" }
 
     public func encode(with aCoder: NSCoder) {
+        if BuildFlags.writeCompactGroupMemberships, encodeCompact(with: aCoder) {
+            return
+        }
+        encodeKeyed(with: aCoder)
+    }
+
+    /// Encodes in the ``CompactMembershipCoding`` form. Returns false, having
+    /// encoded nothing, for memberships it can't represent: those with
+    /// members who have no service ID, which only legacy groups can have.
+    func encodeCompact(with aCoder: NSCoder) -> Bool {
+        let compactData = CompactMembershipCoding.encode(
+            memberStates: memberStates,
+            bannedMembers: bannedMembers,
+            invalidInviteMap: invalidInviteMap,
+            memberLabels: memberLabels,
+        )
+        guard let compactData else {
+            return false
+        }
+        aCoder.encode(compactData, forKey: Self.compactContentsKey)
+        return true
+    }
+
+    /// Encodes in the keyed form that predates ``CompactMembershipCoding``,
+    /// which every build can decode.
+    func encodeKeyed(with aCoder: NSCoder) {
         let encoder = JSONEncoder()
         do {
             let memberStatesData = try encoder.encode(self.memberStates)
@@ -259,6 +311,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
         memberLabels: MemberLabelsMap,
     ) {
         self.memberStates = memberStates
+        self.partitions = Partitions(memberStates: memberStates)
         self.bannedMembers = bannedMembers
         self.invalidInviteMap = invalidInviteMap
         self.memberLabels = memberLabels
@@ -271,6 +324,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
         var builder = Builder()
         builder.addFullMembers(Set(v1Members), role: .normal)
         self.memberStates = builder.memberStates
+        self.partitions = Partitions(memberStates: builder.memberStates)
         self.bannedMembers = [:]
         self.invalidInviteMap = [:]
         self.memberLabels = [:]
@@ -278,15 +332,28 @@ public class GroupMembership: NSObject, NSSecureCoding {
         super.init()
     }
 
+    /// - Parameter changedMemberServiceIds
+    /// If known, the only members whose state may differ between the two
+    /// memberships; only they are compared.
     public func showInfoMessageForChangeComparedTo(
         to other: GroupMembership,
+        changedMemberServiceIds: Set<ServiceId>? = nil,
     ) -> Bool {
-        guard
-            Self.memberStates(
+        let areMemberStatesEqual: Bool
+        if let changedMemberServiceIds {
+            areMemberStatesEqual = changedMemberServiceIds.allSatisfy { serviceId in
+                return Self.memberState(
+                    self.memberState(for: serviceId),
+                    isEqualTo: other.memberState(for: serviceId),
+                )
+            }
+        } else {
+            areMemberStatesEqual = Self.memberStates(
                 self.memberStates,
                 areEqualTo: other.memberStates,
             )
-        else {
+        }
+        guard areMemberStatesEqual else {
             return true
         }
 
@@ -347,8 +414,21 @@ public class GroupMembership: NSObject, NSSecureCoding {
         _ memberStates: MemberStateMap,
         areEqualTo otherMemberStates: MemberStateMap,
     ) -> Bool {
+        guard memberStates.count == otherMemberStates.count else {
+            return false
+        }
+
+        return memberStates.allSatisfy { key, value -> Bool in
+            guard let otherValue = otherMemberStates[key] else { return false }
+            return memberState(value, isEqualTo: otherValue)
+        }
+    }
 
-        func hardcodeDidJoinViaInviteLink(for groupMemberState: GroupMemberState) -> GroupMemberState {
+    private static func memberState(
+        _ memberState: GroupMemberState?,
+        isEqualTo otherMemberState: GroupMemberState?,
+    ) -> Bool {
+        func hardcodeDidJoinViaInviteLink(for groupMemberState: GroupMemberState?) -> GroupMemberState? {
             switch groupMemberState {
             case .fullMember(let role, _, _):
                 return .fullMember(
@@ -361,14 +441,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
             }
         }
 
-        guard memberStates.count == otherMemberStates.count else {
-            return false
-        }
-
-        return memberStates.allSatisfy { key, value -> Bool in
-            guard let otherValue = otherMemberStates[key] else { return false }
-            return hardcodeDidJoinViaInviteLink(for: value) == hardcodeDidJoinViaInviteLink(for: otherValue)
-        }
+        return hardcodeDidJoinViaInviteLink(for: memberState) == hardcodeDidJoinViaInviteLink(for: otherMemberState)
     }
 
     // MARK: -
@@ -430,11 +503,11 @@ public class GroupMembership: NSObject, NSSecureCoding {
     // MARK: -
 
     public var allMembersOfAnyKind: Set<SignalServiceAddress> {
-        return Set(memberStates.keys)
+        return partitions.allMembers
     }
 
     public var allMembersOfAnyKindServiceIds: Set<ServiceId> {
-        return Set(memberStates.keys.lazy.compactMap { $0.serviceId })
+        return partitions.allMemberServiceIds
     }
 
     public func isMemberOfAnyKind(_ address: SignalServiceAddress) -> Bool {
@@ -442,13 +515,26 @@ public class GroupMembership: NSObject, NSSecureCoding {
     }
 
     public func isMemberOfAnyKind(_ serviceId: ServiceId) -> Bool {
-        return isMemberOfAnyKind(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId) != nil
+    }
+
+    /// Looks up a member without building a ``SignalServiceAddress``.
+    private func memberState(for serviceId: ServiceId) -> GroupMemberState? {
+        if let memberState = partitions.memberStatesByServiceId[serviceId] {
+            return memberState
+        }
+        // A member known only by phone number may have had their service ID
+        // learned since we were built.
+        guard partitions.hasMembersWithoutServiceId else {
+            return nil
+        }
+        return memberStates[SignalServiceAddress(serviceId)]
     }
 
     // MARK: -
 
     public func role(for serviceId: ServiceId) -> TSGroupMemberRole? {
-        return role(for: SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.role
     }
 
     public func role(for address: SignalServiceAddress) -> TSGroupMemberRole? {
@@ -461,11 +547,11 @@ public class GroupMembership: NSObject, NSSecureCoding {
     // MARK: -
 
     public var fullMemberAdministrators: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isAdministrator && $0.value.isFullMember }.map { $0.key })
+        return partitions.fullMemberAdministrators
     }
 
     public var fullMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isFullMember }.map { $0.key })
+        return partitions.fullMembers
     }
 
     public func isFullMemberAndAdministrator(_ address: SignalServiceAddress) -> Bool {
@@ -476,7 +562,10 @@ public class GroupMembership: NSObject, NSSecureCoding {
     }
 
     public func isFullMemberAndAdministrator(_ serviceId: ServiceId) -> Bool {
-        return isFullMemberAndAdministrator(SignalServiceAddress(serviceId))
+        guard let memberState = self.memberState(for: serviceId) else {
+            return false
+        }
+        return memberState.isAdministrator && memberState.isFullMember
     }
 
     @objc
@@ -488,7 +577,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
     }
 
     public func isFullMember(_ serviceId: ServiceId) -> Bool {
-        return isFullMember(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.isFullMember ?? false
     }
 
     /// This method should only be called for full members.
@@ -524,7 +613,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
     // MARK: -
 
     public var invitedMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isInvited }.map { $0.key })
+        return partitions.invitedMembers
     }
 
     public func isInvitedMember(_ address: SignalServiceAddress) -> Bool {
@@ -535,7 +624,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
     }
 
     public func isInvitedMember(_ serviceId: ServiceId) -> Bool {
-        return isInvitedMember(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.isInvited ?? false
     }
 
     /// This method should only be called on invited members.
@@ -553,13 +642,22 @@ public class GroupMembership: NSObject, NSSecureCoding {
     }
 
     public func addedByAci(forInvitedMember serviceId: ServiceId) -> Aci? {
-        return addedByAci(forInvitedMember: SignalServiceAddress(serviceId))
+        guard let memberState = self.memberState(for: serviceId) else {
+            return nil
+        }
+        switch memberState {
+        case .invited(_, let addedByAci):
+            return addedByAci
+        default:
+            owsFailDebug("Not a pending profile key member.")
+            return nil
+        }
     }
 
     // MARK: -
 
     public var requestingMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isRequesting }.map { $0.key })
+        return partitions.requestingMembers
     }
 
     public func isRequestingMember(_ address: SignalServiceAddress) -> Bool {
@@ -570,7 +668,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
     }
 
     public func isRequestingMember(_ serviceId: ServiceId) -> Bool {
-        return isRequestingMember(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.isRequesting ?? false
     }
 
     // MARK: -
@@ -609,7 +707,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
 
     /// Is this user's profile key exposed to the group?
     public func hasProfileKeyInGroup(serviceId: ServiceId) -> Bool {
-        guard let memberState = memberStates[SignalServiceAddress(serviceId)] else {
+        guard let memberState = self.memberState(for: serviceId) else {
             return false
         }
 
@@ -623,7 +721,7 @@ public class GroupMembership: NSObject, NSSecureCoding {
 
     /// Can this user view the profile keys in the group?
     public func canViewProfileKeys(serviceId: ServiceId) -> Bool {
-        guard let memberState = memberStates[SignalServiceAddress(serviceId)] else {
+        guard let memberState = self.memberState(for: serviceId) else {
             return false
         }
 
@@ -684,6 +782,56 @@ public class GroupMembership: NSObject, NSSecureCoding {
         return memberLabels[aci]
     }
 
+    // MARK: - Partitions
+
+    private struct Partitions {
+        let allMembers: Set<SignalServiceAddress>
+        let allMemberServiceIds: Set<ServiceId>
+        let fullMembers: Set<SignalServiceAddress>
+        let fullMemberAdministrators: Set<SignalServiceAddress>
+        let invitedMembers: Set<SignalServiceAddress>
+        let requestingMembers: Set<SignalServiceAddress>
+        let memberStatesByServiceId: [ServiceId: GroupMemberState]
+        let hasMembersWithoutServiceId: Bool
+
+        init(memberStates: MemberStateMap) {
+            var fullMembers = Set<SignalServiceAddress>()
+            var fullMemberAdministrators = Set<SignalServiceAddress>()
+            var invitedMembers = Set<SignalServiceAddress>()
+            var requestingMembers = Set<SignalServiceAddress>()
+            var memberStatesByServiceId = [ServiceId: GroupMemberState](minimumCapacity: memberStates.count)
+            var hasMembersWithoutServiceId = false
+
+            for (address, memberState) in memberStates {
+                switch memberState {
+                case .fullMember:
+                    fullMembers.insert(address)
+                    if memberState.isAdministrator {
+                        fullMemberAdministrators.insert(address)
+                    }
+                case .invited:
+                    invitedMembers.insert(address)
+                case .requesting:
+                    requestingMembers.insert(address)
+                }
+                if let serviceId = address.serviceId {
+                    memberStatesByServiceId[serviceId] = memberState
+                } else {
+                    hasMembersWithoutServiceId = true
+                }
+            }
+
+            self.allMembers = Set(memberStates.keys)
+            self.allMemberServiceIds = Set(memberStatesByServiceId.keys)
+            self.fullMembers = fullMembers
+            self.fullMemberAdministrators = fullMemberAdministrators
+            self.invitedMembers = invitedMembers
+            self.requestingMembers = requestingMembers
+            self.memberStatesByServiceId = memberStatesByServiceId
+            self.hasMembersWithoutServiceId = hasMembersWithoutServiceId
+        }
+    }
+
     // MARK: - Builder
 
     public struct Builder {
@@ -982,6 +1130,266 @@ public class GroupMembership: NSObject, NSSecureCoding {
     }
 }
 
+// MARK: - CompactMembershipCoding
+
+/// A compact binary form of a membership, archived under one key in place of
+/// the JSON and dictionaries of the keyed form. For large groups it's a
+/// fraction of the size, and much quicker to decode.
+///
+/// Counts, lengths and timestamps are varints; UUIDs are 16 raw bytes.
+/// Version 1 is the version byte followed by:
+/// - The members. Each is a flags byte (state, role, how they joined, and
+///   whether they're a PNI), their UUID and, if invited, their inviter's.
+/// - The banned members. Each is an ACI's UUID and when they were banned.
+/// - The invalid invites. Each is the user ID, then a byte saying which of
+///   the model's IDs are present, then those IDs.
+/// - The member labels. Each is an ACI's UUID, the label, a byte saying
+///   whether there's an emoji, and the emoji.
+/// Byte strings and strings are prefixed by their length.
+private enum CompactMembershipCoding {
+    static let version: UInt8 = 1
+
+    struct Contents {
+        var memberStates = GroupMembership.MemberStateMap()
+        var bannedMembers = GroupMembership.BannedMembersMap()
+        var invalidInviteMap = GroupMembership.InvalidInviteMap()
+        var memberLabels = GroupMembership.MemberLabelsMap()
+    }
+
+    private struct MemberFlags: OptionSet {
+        let rawValue: UInt8
+
+        /// Neither this nor `requesting` means a full member.
+        static let invited = MemberFlags(rawValue: 1 << 0)
+        static let requesting = MemberFlags(rawValue: 1 << 1)
+        static let administrator = MemberFlags(rawValue: 1 << 2)
+        static let didJoinFromInviteLink = MemberFlags(rawValue: 1 << 3)
+        static let didJoinFromAcceptedJoinRequest = MemberFlags(rawValue: 1 << 4)
+        static let isPni = MemberFlags(rawValue: 1 << 5)
+    }
+
+    private struct PresenceFlags: OptionSet {
+        let rawValue: UInt8
+
+        static let first = PresenceFlags(rawValue: 1 << 0)
+        static let second = PresenceFlags(rawValue: 1 << 1)
+    }
+
+    // MARK: Encoding
+
+    /// Returns nil if a member has no service ID.
+    static func encode(
+        memberStates: GroupMembership.MemberStateMap,
+        bannedMembers: GroupMembership.BannedMembersMap,
+        invalidInviteMap: GroupMembership.InvalidInviteMap,
+        memberLabels: GroupMembership.MemberLabelsMap,
+    ) -> Data? {
+        var data = Data()
+        // Most of the space goes to members, who each take 17 or 33 bytes.
+        data.reserveCapacity(64 + memberStates.count * 20)
+        data.append(version)
+
+        data.appendVarint(UInt64(memberStates.count))
+        for (address, memberState) in memberStates {
+            guard let serviceId = address.serviceId else {
+                return nil
+            }
+            var flags: MemberFlags = serviceId is Pni ? [.isPni] : []
+            if memberState.isAdministrator {
+                flags.insert(.administrator)
+            }
+            var inviterAci: Aci?
+            switch memberState {
+            case .fullMember(_, let didJoinFromInviteLink, let didJoinFromAcceptedJoinRequest):
+                if didJoinFromInviteLink {
+                    flags.insert(.didJoinFromInviteLink)
+                }
+                if didJoinFromAcceptedJoinRequest {
+                    flags.insert(.didJoinFromAcceptedJoinRequest)
+                }
+            case .invited(_, let addedByAci):
+                flags.insert(.invited)
+                inviterAci = addedByAci
+            case .requesting:
+                flags.insert(.requesting)
+            }
+            data.append(flags.rawValue)
+            data.append(serviceId.rawUUID.data)
+            if let inviterAci {
+                data.append(inviterAci.rawUUID.data)
+            }
+        }
+
+        data.appendVarint(UInt64(bannedMembers.count))
+        for (aci, bannedAtTimestamp) in bannedMembers {
+            data.append(aci.rawUUID.data)
+            data.appendVarint(bannedAtTimestamp)
+        }
+
+        data.appendVarint(UInt64(invalidInviteMap.count))
+        for (userId, invalidInvite) in invalidInviteMap {
+            appendBytes(userId, to: &data)
+            appendOptionalBytes(invalidInvite.userId, invalidInvite.addedByUserId, to: &data)
+        }
+
+        data.appendVarint(UInt64(memberLabels.count))
+        for (aci, memberLabel) in memberLabels {
+            data.append(aci.rawUUID.data)
+            appendBytes(Data(memberLabel.label.utf8), to: &data)
+            appendOptionalBytes(memberLabel.labelEmoji.map { Data($0.utf8) }, nil, to: &data)
+        }
+
+        return data
+    }
+
+    private static func appendBytes(_ bytes: Data, to data: inout Data) {
+        data.appendVarint(UInt64(bytes.count))
+        data.append(bytes)
+    }
+
+    private static func appendOptionalBytes(_ first: Data?, _ second: Data?, to data: inout Data) {
+        var presenceFlags = PresenceFlags()
+        if first != nil {
+            presenceFlags.insert(.first)
+        }
+        if second != nil {
+            presenceFlags.insert(.second)
+        }
+        data.append(presenceFlags.rawValue)
+        if let first {
+            appendBytes(first, to: &data)
+        }
+        if let second {
+            appendBytes(second, to: &data)
+        }
+    }
+
+    // MARK: Decoding
+
+    static func decode(_ data: Data) throws -> Contents {
+        var reader = Reader(data: data)
+        let version = try reader.readByte()
+        guard version == Self.version else {
+            throw OWSAssertionError("Unknown compact membership version: \(version)")
+        }
+
+        var contents = Contents()
+
+        let memberCount = try reader.readCount()
+        contents.memberStates.reserveCapacity(memberCount)
+        for _ in 0..<memberCount {
+            let flags = MemberFlags(rawValue: try reader.readByte())
+            let uuid = try reader.readUuid()
+            let serviceId: ServiceId = flags.contains(.isPni) ? Pni(fromUUID: uuid) : Aci(fromUUID: uuid)
+            let role: TSGroupMemberRole = flags.contains(.administrator) ? .administrator : .normal
+
+            let memberState: GroupMemberState
+            if flags.contains(.invited) {
+                memberState = .invited(role: role, addedByAci: Aci(fromUUID: try reader.readUuid()))
+            } else if flags.contains(.requesting) {
+                memberState = .requesting
+            } else {
+                memberState = .fullMember(
+                    role: role,
+                    didJoinFromInviteLink: flags.contains(.didJoinFromInviteLink),
+                    didJoinFromAcceptedJoinRequest: flags.contains(.didJoinFromAcceptedJoinRequest),
+                )
+            }
+            contents.memberStates[SignalServiceAddress(serviceId)] = memberState
+        }
+
+        let bannedMemberCount = try reader.readCount()
+        contents.bannedMembers.reserveCapacity(bannedMemberCount)
+        for _ in 0..<bannedMemberCount {
+            let aci = Aci(fromUUID: try reader.readUuid())
+            contents.bannedMembers[aci] = try reader.readVarint()
+        }
+
+        let invalidInviteCount = try reader.readCount()
+        for _ in 0..<invalidInviteCount {
+            let userId = try reader.readBytes()
+            let (inviteUserId, addedByUserId) = try reader.readOptionalBytes()
+            contents.invalidInviteMap[userId] = InvalidInviteModel(userId: inviteUserId, addedByUserId: addedByUserId)
+        }
+
+        let memberLabelCount = try reader.readCount()
+        for _ in 0..<memberLabelCount {
+            let aci = Aci(fromUUID: try reader.readUuid())
+            let label = try reader.readString()
+            let (labelEmojiData, _) = try reader.readOptionalBytes()
+            let labelEmoji = try labelEmojiData.map { try Reader.string(from: $0) }
+            contents.memberLabels[aci] = MemberLabel(label: label, labelEmoji: labelEmoji)
+        }
+
+        guard reader.isAtEnd else {
+            throw OWSAssertionError("Unexpected trailing bytes.")
+        }
+        return contents
+    }
+
+    private struct Reader {
+        private var data: Data
+
+        init(data: Data) {
+            self.data = data
+        }
+
+        var isAtEnd: Bool { data.isEmpty }
+
+        mutating func readByte() throws -> UInt8 {
+            guard let byte = data.popFirst() else {
+                throw OWSAssertionError("Truncated compact membership.")
+            }
+            return byte
+        }
+
+        mutating func readVarint() throws -> UInt64 {
+            return try data.removeFirstVarint()
+        }
+
+        /// Reads a count of things that each take at least a byte.
+        mutating func readCount() throws -> Int {
+            let count = try readVarint()
+            guard count <= data.count else {
+                throw OWSAssertionError("Count exceeds remaining bytes.")
+            }
+            return Int(count)
+        }
+
+        mutating func readUuid() throws -> UUID {
+            guard let (uuid, byteCount) = UUID.from(data: data) else {
+                throw OWSAssertionError("Truncated compact membership.")
+            }
+            data = data.dropFirst(byteCount)
+            return uuid
+        }
+
+        mutating func readBytes() throws -> Data {
+            let count = try readCount()
+            defer { data = data.dropFirst(count) }
+            return Data(data.prefix(count))
+        }
+
+        mutating func readString() throws -> String {
+            return try Self.string(from: try readBytes())
+        }
+
+        mutating func readOptionalBytes() throws -> (Data?, Data?) {
+            let presenceFlags = PresenceFlags(rawValue: try readByte())
+            let first = presenceFlags.contains(.first) ? try readBytes() : nil
+            let second = presenceFlags.contains(.second) ? try readBytes() : nil
+            return (first, second)
+        }
+
+        static func string(from data: Data) throws -> String {
+            guard let string = String(data: data, encoding: .utf8) else {
+                throw OWSAssertionError("Invalid UTF-8.")
+            }
+            return string
+        }
+    }
+}
+
 // MARK: - InvalidInviteModel
 
 @objc(GroupMembershipInvalidInviteModel)
@@ -0,0 +1,147 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import LibSignalClient
+
+/// Keeps the endorsements of recently-sent-to groups decoded in memory, so
+/// that each send to a group doesn't parse an endorsement and fetch a
+/// recipient for every member.
+///
+/// Entries are checked against the group's combined endorsement, which is
+/// read for every lookup. New endorsements always come with a new combined
+/// endorsement, so a stale entry is noticed and rebuilt. When an entry is
+/// rebuilt after a membership change, members whose endorsements haven't
+/// changed are carried over rather than decoded again.
+final class GroupSendEndorsementCache {
+
+    struct Metrics {
+        /// Lookups answered by an entry that was already built.
+        var hitCount = 0
+        /// Lookups that had to build an entry.
+        var buildCount = 0
+        /// Individual endorsements decoded while building entries.
+        var decodedEndorsementCount = 0
+        /// Individual endorsements carried over from an entry's previous build.
+        var reusedEndorsementCount = 0
+        /// Total time spent building entries.
+        var buildDuration: TimeInterval = 0
+    }
+
+    private final class Entry {
+        let combinedRecord: CombinedGroupSendEndorsementRecord
+        let individualRecords: [SignalRecipient.RowId: (endorsement: Data, serviceId: ServiceId)]
+        let endorsements: GroupSendEndorsements
+
+        init(
+            combinedRecord: CombinedGroupSendEndorsementRecord,
+            individualRecords: [SignalRecipient.RowId: (endorsement: Data, serviceId: ServiceId)],
+            endorsements: GroupSendEndorsements,
+        ) {
+            self.combinedRecord = combinedRecord
+            self.individualRecords = individualRecords
+            self.endorsements = endorsements
+        }
+
+        func matches(_ combinedRecord: CombinedGroupSendEndorsementRecord) -> Bool {
+            return (
+                self.combinedRecord.expiration == combinedRecord.expiration
+                    && self.combinedRecord.endorsement == combinedRecord.endorsement
+            )
+        }
+    }
+
+    private let groupSendEndorsementStore: GroupSendEndorsementStore
+    private let recipientDatabaseTable: RecipientDatabaseTable
+
+    private let entries = LRUCache<GroupRecord.RowId, Entry>(maxSize: 16)
+    private let _metrics = TSMutex(initialState: Metrics())
+
+    init(
+        groupSendEndorsementStore: GroupSendEndorsementStore,
+        recipientDatabaseTable: RecipientDatabaseTable,
+    ) {
+        self.groupSendEndorsementStore = groupSendEndorsementStore
+        self.recipientDatabaseTable = recipientDatabaseTable
+    }
+
+    var metrics: Metrics {
+        return _metrics.withLock { $0 }
+    }
+
+    /// Returns the group's endorsements, or nil if it doesn't have any.
+    func fetchEndorsements(
+        groupRowId: GroupRecord.RowId,
+        secretParams: GroupSecretParams,
+        tx: DBReadTransaction,
+    ) throws -> GroupSendEndorsements? {
+        let combinedRecord = groupSendEndorsementStore.fetchCombinedEndorsement(groupRowId: groupRowId, tx: tx)
+        guard let combinedRecord else {
+            return nil
+        }
+
+        let previousEntry = entries.get(key: groupRowId)
+        if let previousEntry, previousEntry.matches(combinedRecord) {
+            _metrics.withLock { $0.hitCount += 1 }
+            return previousEntry.endorsements
+        }
+
+        let startDate = MonotonicDate()
+        var decodedEndorsementCount = 0
+        var reusedEndorsementCount = 0
+
+        var individualRecords = [SignalRecipient.RowId: (endorsement: Data, serviceId: ServiceId)]()
+        var individualEndorsements = [ServiceId: GroupSendEndorsement]()
+        for record in groupSendEndorsementStore.fetchIndividualEndorsements(groupRowId: groupRowId, tx: tx) {
+            // Full members are ACIs, and a recipient's ACI never changes, so a
+            // member whose endorsement is unchanged is still the same member.
+            if
+                let previousRecord = previousEntry?.individualRecords[record.recipientId],
+                previousRecord.endorsement == record.endorsement,
+                let endorsement = previousEntry?.endorsements.individual[previousRecord.serviceId]
+            {
+                individualRecords[record.recipientId] = previousRecord
+                individualEndorsements[previousRecord.serviceId] = endorsement
+                reusedEndorsementCount += 1
+                continue
+            }
+
+            let endorsement = try GroupSendEndorsement(contents: record.endorsement)
+            let recipient = recipientDatabaseTable.fetchRecipient(rowId: record.recipientId, tx: tx)
+            guard let recipient else {
+                throw OWSAssertionError("Missing Recipient that must exist.")
+            }
+            guard let serviceId = recipient.aci ?? recipient.pni else {
+                throw OWSAssertionError("Missing ServiceId that must exist.")
+            }
+            individualRecords[record.recipientId] = (record.endorsement, serviceId)
+            individualEndorsements[serviceId] = endorsement
+            decodedEndorsementCount += 1
+        }
+
+        let endorsements = GroupSendEndorsements(
+            secretParams: secretParams,
+            expiration: combinedRecord.expiration,
+            combined: try GroupSendEndorsement(contents: combinedRecord.endorsement),
+            individual: individualEndorsements,
+        )
+        entries.set(key: groupRowId, value: Entry(
+            combinedRecord: combinedRecord,
+            individualRecords: individualRecords,
+            endorsements: endorsements,
+        ))
+
+        let buildDuration = (MonotonicDate() - startDate).seconds
+        _metrics.withLock {
+            $0.buildCount += 1
+            $0.decodedEndorsementCount += decodedEndorsementCount
+            $0.reusedEndorsementCount += reusedEndorsementCount
+            $0.buildDuration += buildDuration
+        }
+        Logger.info("Built GSEs for group \(groupRowId) in \(Int(buildDuration * 1000))ms; decoded \(decodedEndorsementCount), reused \(reusedEndorsementCount)")
+
+        return endorsements
+    }
+}
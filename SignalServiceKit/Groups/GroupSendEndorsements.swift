@@ -7,10 +7,25 @@ import Foundation
 import LibSignalClient
 
 struct GroupSendEndorsements {
-    var secretParams: GroupSecretParams
-    var expiration: Date
-    var combined: GroupSendEndorsement
-    var individual: [ServiceId: GroupSendEndorsement]
+    let secretParams: GroupSecretParams
+    let expiration: Date
+    let combined: GroupSendEndorsement
+    let individual: [ServiceId: GroupSendEndorsement]
+    /// Shared by copies, so that endorsements cached by
+    /// ``GroupSendEndorsementCache`` remember their results across sends.
+    private let combinedExcludingCache = CombinedExcludingCache()
+
+    init(
+        secretParams: GroupSecretParams,
+        expiration: Date,
+        combined: GroupSendEndorsement,
+        individual: [ServiceId: GroupSendEndorsement],
+    ) {
+        self.secretParams = secretParams
+        self.expiration = expiration
+        self.combined = combined
+        self.individual = individual
+    }
 
     func tokenBuilder(forServiceId serviceId: ServiceId) -> GroupSendFullTokenBuilder? {
         return individual[serviceId].map {
@@ -18,7 +33,50 @@ struct GroupSendEndorsements {
         }
     }
 
+    /// Builds a token for the combined endorsement less the endorsements of
+    /// `excludedServiceIds`, each of which must have an individual endorsement.
+    ///
+    /// Sends to a group tend to exclude the same members each time, so recent
+    /// results are remembered rather than removing each member again.
+    func combinedTokenBuilder(excluding excludedServiceIds: Set<ServiceId>) -> GroupSendFullTokenBuilder {
+        let endorsement = combinedExcludingCache.endorsement(excluding: excludedServiceIds) {
+            var combined = self.combined
+            for serviceId in excludedServiceIds {
+                combined = combined.byRemoving(individual[serviceId]!)
+            }
+            return combined
+        }
+        return GroupSendFullTokenBuilder(secretParams: secretParams, expiration: expiration, endorsement: endorsement)
+    }
+
     static func willExpireSoon(expirationDate: Date?) -> Bool {
         return expirationDate == nil || expirationDate!.timeIntervalSinceNow < 2 * .hour
     }
 }
+
+// MARK: -
+
+/// The last few combined endorsements derived by excluding members, keyed
+/// by the members that were excluded.
+final class CombinedExcludingCache {
+    static let maxCount = 4
+
+    private let endorsements = TSMutex<[Set<ServiceId>: GroupSendEndorsement]>(initialState: [:])
+
+    func endorsement(
+        excluding excludedServiceIds: Set<ServiceId>,
+        build: () -> GroupSendEndorsement,
+    ) -> GroupSendEndorsement {
+        if let endorsement = endorsements.withLock({ $0[excludedServiceIds] }) {
+            return endorsement
+        }
+        let endorsement = build()
+        endorsements.withLock {
+            if $0.count >= Self.maxCount {
+                $0.removeAll()
+            }
+            $0[excludedServiceIds] = endorsement
+        }
+        return endorsement
+    }
+}
@@ -26,6 +26,7 @@ public protocol GroupUpdateInfoMessageInserter {
         oldDisappearingMessageToken: DisappearingMessageToken,
         newDisappearingMessageToken: DisappearingMessageToken,
         newlyLearnedPniToAciAssociations: [Pni: Aci],
+        changedMemberServiceIds: Set<ServiceId>?,
         groupUpdateSource: GroupUpdateSource,
         transaction: DBWriteTransaction,
     )
@@ -64,6 +65,7 @@ class GroupUpdateInfoMessageInserterImpl: GroupUpdateInfoMessageInserter {
             oldDisappearingMessageToken: nil,
             newDisappearingMessageToken: disappearingMessageToken,
             newlyLearnedPniToAciAssociations: [:],
+            changedMemberServiceIds: nil,
             groupUpdateSource: groupUpdateSource,
             transaction: tx,
         )
@@ -78,6 +80,7 @@ class GroupUpdateInfoMessageInserterImpl: GroupUpdateInfoMessageInserter {
         oldDisappearingMessageToken: DisappearingMessageToken,
         newDisappearingMessageToken: DisappearingMessageToken,
         newlyLearnedPniToAciAssociations: [Pni: Aci],
+        changedMemberServiceIds: Set<ServiceId>?,
         groupUpdateSource: GroupUpdateSource,
         transaction tx: DBWriteTransaction,
     ) {
@@ -90,6 +93,7 @@ class GroupUpdateInfoMessageInserterImpl: GroupUpdateInfoMessageInserter {
             oldDisappearingMessageToken: oldDisappearingMessageToken,
             newDisappearingMessageToken: newDisappearingMessageToken,
             newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
+            changedMemberServiceIds: changedMemberServiceIds,
             groupUpdateSource: groupUpdateSource,
             transaction: tx,
         )
@@ -104,6 +108,7 @@ class GroupUpdateInfoMessageInserterImpl: GroupUpdateInfoMessageInserter {
         oldDisappearingMessageToken: DisappearingMessageToken?,
         newDisappearingMessageToken: DisappearingMessageToken,
         newlyLearnedPniToAciAssociations: [Pni: Aci],
+        changedMemberServiceIds: Set<ServiceId>?,
         groupUpdateSource: GroupUpdateSource,
         transaction tx: DBWriteTransaction,
     ) {
@@ -136,6 +141,7 @@ class GroupUpdateInfoMessageInserterImpl: GroupUpdateInfoMessageInserter {
                         newGroupModel: newGroupModel,
                         oldDisappearingMessageToken: oldDisappearingMessageToken,
                         newDisappearingMessageToken: newDisappearingMessageToken,
+                        changedMemberServiceIds: changedMemberServiceIds,
                         localIdentifiers: localIdentifiers,
                         groupUpdateSource: groupUpdateSource,
                         tx: tx,
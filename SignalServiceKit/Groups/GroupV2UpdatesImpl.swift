@@ -163,6 +163,7 @@ public class GroupV2UpdatesImpl: GroupV2Updates {
             newGroupModel: changedGroupModel.newGroupModel,
             newDisappearingMessageToken: changedGroupModel.newDisappearingMessageToken,
             newlyLearnedPniToAciAssociations: changedGroupModel.newlyLearnedPniToAciAssociations,
+            changedMemberServiceIds: changedGroupModel.changedMemberServiceIds,
             groupUpdateSource: changedGroupModel.updateSource,
             localIdentifiers: localIdentifiers,
             localDeviceId: localDeviceId,
@@ -713,6 +714,7 @@ public extension GroupV2UpdatesImpl {
         let newDisappearingMessageToken: DisappearingMessageToken?
         let newProfileKeys: [Aci: Data]
         let newlyLearnedPniToAciAssociations: [Pni: Aci]
+        let changedMemberServiceIds: Set<ServiceId>?
         let groupUpdateSource: GroupUpdateSource
 
         // We should prefer to update models using the change action if we can,
@@ -735,6 +737,7 @@ public extension GroupV2UpdatesImpl {
             newDisappearingMessageToken = changedGroupModel.newDisappearingMessageToken
             newProfileKeys = changedGroupModel.profileKeys
             newlyLearnedPniToAciAssociations = changedGroupModel.newlyLearnedPniToAciAssociations
+            changedMemberServiceIds = changedGroupModel.changedMemberServiceIds
             groupUpdateSource = changedGroupModel.updateSource
         } else if let snapshot = groupChange.snapshot {
             logger.info("Applying snapshot.")
@@ -748,6 +751,8 @@ public extension GroupV2UpdatesImpl {
             newDisappearingMessageToken = snapshot.disappearingMessageToken
             newProfileKeys = snapshot.profileKeys
             newlyLearnedPniToAciAssociations = [:]
+            // Snapshots don't say what changed, so the models must be compared.
+            changedMemberServiceIds = nil
             // Snapshots don't have a single author, so we don't know the source.
             groupUpdateSource = .unknown
         } else {
@@ -760,6 +765,7 @@ public extension GroupV2UpdatesImpl {
             newGroupModel: newGroupModel,
             newDisappearingMessageToken: newDisappearingMessageToken,
             newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
+            changedMemberServiceIds: changedMemberServiceIds,
             groupUpdateSource: groupUpdateSource,
             localIdentifiers: localIdentifiers,
             localDeviceId: localDeviceId,
@@ -21,6 +21,11 @@ public struct ChangedGroupModel {
     /// Whether we should update the last verified name hash because the local user changed it.
     public let shouldUpdateLastVerifiedGroupNameHash: Bool
 
+    /// The members whose membership (full, invited or requesting, and role)
+    /// the applied actions may have changed. Every other member's state is
+    /// the same in both models.
+    public let changedMemberServiceIds: Set<ServiceId>
+
     public init(
         oldGroupModel: TSGroupModelV2,
         newGroupModel: TSGroupModelV2,
@@ -29,6 +34,7 @@ public struct ChangedGroupModel {
         profileKeys: [Aci: Data],
         newlyLearnedPniToAciAssociations: [Pni: Aci],
         shouldUpdateLastVerifiedGroupNameHash: Bool,
+        changedMemberServiceIds: Set<ServiceId>,
     ) {
         self.oldGroupModel = oldGroupModel
         self.newGroupModel = newGroupModel
@@ -37,6 +43,7 @@ public struct ChangedGroupModel {
         self.profileKeys = profileKeys
         self.newlyLearnedPniToAciAssociations = newlyLearnedPniToAciAssociations
         self.shouldUpdateLastVerifiedGroupNameHash = shouldUpdateLastVerifiedGroupNameHash
+        self.changedMemberServiceIds = changedMemberServiceIds
     }
 }
 
@@ -155,6 +162,10 @@ public class GroupsV2IncomingChanges {
         // change protos.
         var newlyLearnedPniToAciAssociations = [Pni: Aci]()
 
+        // Every action that touches a member's state records them here, so
+        // callers can compare just those members rather than both models.
+        var changedMemberServiceIds = Set<ServiceId>()
+
         for action in changeActionsProto.addMembers {
             let didJoinFromInviteLink = action.joinFromInviteLink
 
@@ -185,6 +196,7 @@ public class GroupsV2IncomingChanges {
             groupMembershipBuilder.removeInvalidInvite(userId: userId)
             groupMembershipBuilder.remove(aci)
             groupMembershipBuilder.addFullMember(aci, role: role, didJoinFromInviteLink: didJoinFromInviteLink)
+            changedMemberServiceIds.insert(aci)
 
             if changeAuthor == localIdentifiers.aci, aci == localIdentifiers.aci {
                 didJustAddSelfViaGroupLink = true
@@ -218,6 +230,7 @@ public class GroupsV2IncomingChanges {
             groupMembershipBuilder.removeInvalidInvite(userId: userId)
             groupMembershipBuilder.remove(aci)
             groupMembershipBuilder.setMemberLabel(label: nil, aci: aci)
+            changedMemberServiceIds.insert(aci)
         }
 
         for action in changeActionsProto.modifyMemberRoles {
@@ -249,6 +262,7 @@ public class GroupsV2IncomingChanges {
             }
             groupMembershipBuilder.remove(aci)
             groupMembershipBuilder.addFullMember(aci, role: role)
+            changedMemberServiceIds.insert(aci)
         }
 
         for action in changeActionsProto.modifyMemberLabel {
@@ -338,6 +352,7 @@ public class GroupsV2IncomingChanges {
             groupMembershipBuilder.removeInvalidInvite(userId: userId)
             groupMembershipBuilder.remove(serviceId)
             groupMembershipBuilder.addInvitedMember(serviceId, role: role, addedByAci: addedByAci)
+            changedMemberServiceIds.insert(serviceId)
         }
 
         for action in changeActionsProto.deletePendingMembers {
@@ -364,6 +379,7 @@ public class GroupsV2IncomingChanges {
                 }
                 groupMembershipBuilder.removeInvalidInvite(userId: userId)
                 groupMembershipBuilder.remove(serviceId)
+                changedMemberServiceIds.insert(serviceId)
             } catch {
                 if !canRemoveMembers {
                     // Admin can revoke any invitation.
@@ -396,6 +412,7 @@ public class GroupsV2IncomingChanges {
             groupMembershipBuilder.removeInvalidInvite(userId: aciCiphertext)
             groupMembershipBuilder.remove(aci)
             groupMembershipBuilder.addFullMember(aci, role: role)
+            changedMemberServiceIds.insert(aci)
 
             if aci != changeAuthor {
                 // Only the invitee can accept an invitation.
@@ -421,12 +438,14 @@ public class GroupsV2IncomingChanges {
             // Clear the invited PNI from the membership...
             groupMembershipBuilder.removeInvalidInvite(userId: pniCiphertext)
             groupMembershipBuilder.remove(pni)
+            changedMemberServiceIds.insert(pni)
 
             // ...and ensure the ACI is a full member...
             if oldGroupMembership.isFullMember(aci) {
                 owsFailDebug("Promoting PNI whose ACI is already a full member!")
             } else {
                 groupMembershipBuilder.addFullMember(aci, role: pniRole)
+                changedMemberServiceIds.insert(aci)
             }
 
             // ...and hold onto the profile key...
@@ -459,6 +478,7 @@ public class GroupsV2IncomingChanges {
             groupMembershipBuilder.removeInvalidInvite(userId: userId)
             groupMembershipBuilder.remove(aci)
             groupMembershipBuilder.addRequestingMember(aci)
+            changedMemberServiceIds.insert(aci)
 
             profileKeys[aci] = profileKey
         }
@@ -482,6 +502,7 @@ public class GroupsV2IncomingChanges {
 
             groupMembershipBuilder.removeInvalidInvite(userId: userId)
             groupMembershipBuilder.remove(aci)
+            changedMemberServiceIds.insert(aci)
         }
 
         for action in changeActionsProto.promoteRequestingMembers {
@@ -513,6 +534,7 @@ public class GroupsV2IncomingChanges {
                 role: role,
                 didJoinFromAcceptedJoinRequest: true,
             )
+            changedMemberServiceIds.insert(aci)
         }
 
         for action in changeActionsProto.addBannedMembers {
@@ -696,6 +718,7 @@ public class GroupsV2IncomingChanges {
             profileKeys: profileKeys,
             newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
             shouldUpdateLastVerifiedGroupNameHash: shouldUpdateLastVerifiedGroupNameHash,
+            changedMemberServiceIds: changedMemberServiceIds,
         )
     }
 }
@@ -211,8 +211,12 @@ public final class TSGroupModelV2: TSGroupModel {
         return Array(groupMembership.fullMembers)
     }
 
+    /// - Parameter changedMemberServiceIds
+    /// If known, the only members whose state may differ between the two
+    /// models.
     public func showInfoMessageForChangeComparedTo(
         to otherGroupModel: TSGroupModelV2,
+        changedMemberServiceIds: Set<ServiceId>? = nil,
     ) -> Bool {
         if self === otherGroupModel {
             return false
@@ -231,7 +235,10 @@ public final class TSGroupModelV2: TSGroupModel {
             avatarChangeRequiresInfoMessage = true
         }
 
-        let membershipChangeRequiresInfoMessage = membership.showInfoMessageForChangeComparedTo(to: otherGroupModel.membership)
+        let membershipChangeRequiresInfoMessage = membership.showInfoMessageForChangeComparedTo(
+            to: otherGroupModel.membership,
+            changedMemberServiceIds: changedMemberServiceIds,
+        )
 
         guard
             groupName == otherGroupModel.groupName,
@@ -107,7 +107,6 @@ private class BulkDeleteInteractionJobRunner: JobRunner {
         return await JobAttemptResult.executeBlockWithDefaultErrorHandler(
             jobRecord: jobRecord,
             retryLimit: Constants.maxRetries,
-            db: db,
             block: {
                 try await _runJobAttempt(jobRecord)
             },
@@ -221,32 +220,15 @@ private class BulkDeleteInteractionJobRunner: JobRunner {
         anchorMessageRowId: Int64,
         tx: DBWriteTransaction,
     ) -> Int {
-        let interactionsToDelete: [TSInteraction]
-        do {
-            interactionsToDelete = try InteractionFinder(
-                threadUniqueId: threadUniqueId,
-            ).fetchAllInteractions(
-                rowIdFilter: .atOrBefore(anchorMessageRowId),
-                limit: Constants.deletionBatchSize,
-                tx: tx,
-            )
-        } catch {
-            owsFailDebug("Failed to get interactions to delete!")
-            return 0
-        }
-
-        if interactionsToDelete.isEmpty { return 0 }
+        let deletedCount = interactionDeleteManager.deleteInteractions(
+            threadUniqueId: threadUniqueId,
+            atOrBeforeRowId: anchorMessageRowId,
+            limit: Constants.deletionBatchSize,
+            associatedCallDelete: .localDeleteOnly,
+            tx: tx,
+        )
 
-        for interaction in interactionsToDelete {
-            interactionDeleteManager.delete(
-                interaction,
-                sideEffects: .custom(
-                    associatedCallDelete: .localDeleteOnly,
-                    updateThreadOnInteractionDelete: .doNotUpdate,
-                ),
-                tx: tx,
-            )
-        }
+        if deletedCount == 0 { return 0 }
 
         /// Above, we're skipping a per-interaction thread update that would
         /// otherwise set various "last visible" properties on the thread. To
@@ -270,7 +252,7 @@ private class BulkDeleteInteractionJobRunner: JobRunner {
             }
         }
 
-        return interactionsToDelete.count
+        return deletedCount
     }
 }
 
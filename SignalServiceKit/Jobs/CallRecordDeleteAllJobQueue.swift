@@ -153,7 +153,6 @@ private class CallRecordDeleteAllJobRunner: JobRunner {
         return await JobAttemptResult.executeBlockWithDefaultErrorHandler(
             jobRecord: jobRecord,
             retryLimit: Constants.maxRetries,
-            db: db,
             block: { await _runJobAttempt(jobRecord) },
         )
     }
@@ -501,10 +501,7 @@ private class DonationReceiptCredentialRedemptionJobRunner: JobRunner {
                 return .retryAfter(incrementExponentialRetryDelay())
             }
             logger.warn("Job encountered unexpected terminal error")
-            return await db.awaitableWrite { tx in
-                jobRecord.anyRemove(transaction: tx)
-                return .finished(.failure(error))
-            }
+            return .finishedPendingRemoval(.failure(error))
         }
     }
 
@@ -84,7 +84,6 @@ private class IncomingContactSyncJobRunner: JobRunner {
         return await JobAttemptResult.executeBlockWithDefaultErrorHandler(
             jobRecord: jobRecord,
             retryLimit: Constants.maxRetries,
-            db: DependenciesBridge.shared.db,
             block: { try await _runJob(jobRecord) },
         )
     }
@@ -15,26 +15,37 @@ public enum JobAttemptResult<Success> {
     /// elapsed (eg, when Reachability reports that we've reconnected).
     case retryAfter(TimeInterval, canRetryEarly: Bool = true)
 
+    /// The Job has succeeded or reached a terminal error, like `.finished`,
+    /// but hasn't removed its `JobRecord`. The `JobQueueRunner` removes it
+    /// instead, possibly in the same transaction as other jobs' records.
+    ///
+    /// Use this when removing the record needn't be atomic with anything else
+    /// the Job wrote.
+    case finishedPendingRemoval(Result<Success, Error>)
+
+    /// The Job threw an error. The `JobQueueRunner` handles it as
+    /// `performDefaultErrorHandler` would, possibly in the same transaction as
+    /// other jobs' records, and then finishes or retries the Job.
+    case failed(Error, retryLimit: UInt)
+
     /// Invokes `block` and handles retryable errors.
     ///
     /// If `block()` succeeds, a terminal success result is returned. In this
     /// case, the caller (or, more typically, `block`) is responsible for
     /// removing the job from the database.
     ///
-    /// If `block()` throws an error, calls `performDefaultErrorHandler`.
+    /// If `block()` throws an error, returns `.failed`, so that the
+    /// `JobQueueRunner` applies the default error handling.
     public static func executeBlockWithDefaultErrorHandler(
         jobRecord: JobRecord,
         retryLimit: UInt,
-        db: any DB,
         block: () async throws -> Success,
     ) async -> JobAttemptResult {
         do {
             let result = try await block()
             return .finished(.success(result))
         } catch {
-            return await db.awaitableWrite { tx in
-                return performDefaultErrorHandler(error: error, jobRecord: jobRecord, retryLimit: retryLimit, tx: tx)
-            }
+            return .failed(error, retryLimit: retryLimit)
         }
     }
 
@@ -51,13 +62,29 @@ public enum JobAttemptResult<Success> {
         jobRecord: JobRecord,
         retryLimit: UInt,
         tx: DBWriteTransaction,
+    ) -> JobAttemptResult {
+        return performDefaultErrorHandler(
+            error: error,
+            jobRecord: jobRecord,
+            retryLimit: retryLimit,
+            removeJobRecord: { jobRecord.anyRemove(transaction: tx) },
+            tx: tx,
+        )
+    }
+
+    fileprivate static func performDefaultErrorHandler(
+        error: Error,
+        jobRecord: JobRecord,
+        retryLimit: UInt,
+        removeJobRecord: () -> Void,
+        tx: DBWriteTransaction,
     ) -> JobAttemptResult {
         if jobRecord.failureCount < retryLimit, error.isRetryable {
             jobRecord.addFailure(tx: tx)
             let delay = OWSOperation.retryIntervalForExponentialBackoff(failureCount: jobRecord.failureCount, maxAverageBackoff: 14.1 * .minute)
             return .retryAfter(delay, canRetryEarly: true)
         } else {
-            jobRecord.anyRemove(transaction: tx)
+            removeJobRecord()
             return .finished(.failure(error))
         }
     }
@@ -116,7 +143,9 @@ public protocol JobRunner<JobRecordType> {
     /// `jobRecord` from the database. Passing this responsibility to
     /// `runJobAttempt` ensures that removing `jobRecord` can be performed
     /// atomically with other database operations. (In DEBUG builds, the caller
-    /// will try to ensure this invariant remains true.)
+    /// will try to ensure this invariant remains true.) Jobs that don't need
+    /// that can return `.finishedPendingRemoval` or `.failed` instead, which
+    /// lets the caller batch their record changes with other jobs'.
     func runJobAttempt(_ jobRecord: JobRecordType) async -> JobAttemptResult<JobAttemptResultSuccessType>
 
     /// Invoked when a job reaches a terminal result.
@@ -155,6 +184,12 @@ public class JobQueueRunner<
     private let jobRunnerFactory: JobRunnerFactoryType
     private var observers = [NSObjectProtocol]()
 
+    /// Applies the record changes that jobs leave to the runner (see
+    /// `JobAttemptResult.finishedPendingRemoval` and `.failed`). When many
+    /// jobs finish or fail at once (eg, when the network goes away), their
+    /// changes share transactions rather than queuing for one each.
+    private let jobRecordWriter: CoalescingDatabaseWriter
+
     private enum Mode {
         /// The runner hasn't been started yet, or the runner is in the process of
         /// starting. In both of these states, new jobs are held until persisted
@@ -198,6 +233,7 @@ public class JobQueueRunner<
         self.db = db
         self.jobFinder = jobFinder
         self.jobRunnerFactory = jobRunnerFactory
+        self.jobRecordWriter = CoalescingDatabaseWriter(db: db)
     }
 
     deinit {
@@ -348,12 +384,14 @@ public class JobQueueRunner<
             return .notFound
         }
 
-        let result = await queuedJob.runner.runJobAttempt(jobRecord)
+        let result = await persistAttemptResult(queuedJob.runner.runJobAttempt(jobRecord), jobRecord: jobRecord)
         switch result {
         case .finished(let result):
             // In DEBUG builds, make sure that .finished jobs were deleted.
             assert(db.read(block: { tx in (try? jobFinder.fetchJob(rowId: queuedJob.rowId, tx: tx)) == nil }))
             return .finished(result)
+        case .finishedPendingRemoval, .failed:
+            owsFail("These are replaced by persistAttemptResult.")
         case .retryAfter(let retryAfter, let canRetryEarly):
             // Create a Task that waits for `retryAfter`. If `retryWaitingJobs` is
             // called, this Task will be canceled, starting the next retry immediately.
@@ -369,6 +407,36 @@ public class JobQueueRunner<
         }
     }
 
+    /// Makes the record changes that `result` leaves to the runner, replacing
+    /// it with `.finished` or `.retryAfter`.
+    ///
+    /// This returns once the changes are committed, so (as when the job makes
+    /// them itself) a job is never finished before its record is removed. If
+    /// the app exits first, the job is run again on the next launch.
+    private func persistAttemptResult(
+        _ result: SignalServiceKit.JobAttemptResult<SuccessType>,
+        jobRecord: JobFinderType.JobRecordType,
+    ) async -> SignalServiceKit.JobAttemptResult<SuccessType> {
+        let jobFinder = self.jobFinder
+        switch result {
+        case .finished, .retryAfter:
+            return result
+        case .finishedPendingRemoval(let result):
+            await jobRecordWriter.write { tx in jobFinder.removeJob(jobRecord, tx: tx) }
+            return .finished(result)
+        case .failed(let error, let retryLimit):
+            return await jobRecordWriter.write { tx in
+                return SignalServiceKit.JobAttemptResult.performDefaultErrorHandler(
+                    error: error,
+                    jobRecord: jobRecord,
+                    retryLimit: retryLimit,
+                    removeJobRecord: { jobFinder.removeJob(jobRecord, tx: tx) },
+                    tx: tx,
+                )
+            }
+        }
+    }
+
     private func startNextJob(state: inout State) {
         switch state.mode {
         case .loading, .serialPaused:
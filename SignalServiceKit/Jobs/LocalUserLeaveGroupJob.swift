@@ -33,7 +33,6 @@ private class LocalUserLeaveGroupJobRunner: JobRunner {
         return await JobAttemptResult.executeBlockWithDefaultErrorHandler(
             jobRecord: jobRecord,
             retryLimit: Constants.maxRetries,
-            db: DependenciesBridge.shared.db,
             block: { try await _runJobAttempt(jobRecord) },
         )
     }
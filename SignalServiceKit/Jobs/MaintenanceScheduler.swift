@@ -0,0 +1,310 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Runs database maintenance (cleanups, expirations, launch-time repairs) in
+/// small write transactions, within budgets, so that it doesn't hold the
+/// write lock for long stretches while the user is doing something.
+///
+/// Maintenance is written as a "step" that does a small amount of work and
+/// reports whether there's more to do. The scheduler runs steps back to back
+/// within a transaction until the transaction has been open for the budget's
+/// `writeLockDuration`, then commits and pauses before the next slice. Steps
+/// must therefore be safe to split across transactions at any point.
+///
+/// There are two ways to run maintenance:
+///
+/// - ``register(uniqueKey:approximateInterval:budget:step:)`` adds a task that
+/// is run every `approximateInterval` or so by ``runDueTasks()``. When a pass
+/// uses up a task's CPU or row budget, the task stops and continues from
+/// where it left off in the next pass.
+///
+/// - ``runUntilDone(name:budget:step:)`` runs a step to completion now, for
+/// work that must finish (eg during launch) but shouldn't hold the lock for
+/// all of it at once.
+///
+/// If a slice has to wait for the write lock, someone else is writing, so the
+/// scheduler doubles the pause before the next slice (up to a limit). The
+/// cost of each task (slices, CPU time, rows written, lock hold and wait
+/// times) is recorded and available via ``costs()``.
+public final class MaintenanceScheduler {
+
+    public struct Budget {
+        /// How long a single slice may hold the write lock.
+        public var writeLockDuration: TimeInterval
+        /// How long to pause between slices, giving other writers a turn.
+        public var pauseBetweenSlices: TimeInterval
+        /// How much CPU time (across all slices) a task may use in one pass of
+        /// ``runDueTasks()``. Ignored by ``runUntilDone(name:budget:step:)``.
+        public var cpuTimePerPass: TimeInterval?
+        /// How many rows (across all slices) a task may insert, update or
+        /// delete in one pass of ``runDueTasks()``. Ignored by
+        /// ``runUntilDone(name:budget:step:)``.
+        public var rowsWrittenPerPass: Int?
+
+        public init(
+            writeLockDuration: TimeInterval,
+            pauseBetweenSlices: TimeInterval,
+            cpuTimePerPass: TimeInterval? = nil,
+            rowsWrittenPerPass: Int? = nil,
+        ) {
+            self.writeLockDuration = writeLockDuration
+            self.pauseBetweenSlices = pauseBetweenSlices
+            self.cpuTimePerPass = cpuTimePerPass
+            self.rowsWrittenPerPass = rowsWrittenPerPass
+        }
+
+        /// For periodic cleanups that can be put off.
+        public static let idle = Budget(
+            writeLockDuration: 0.05,
+            pauseBetweenSlices: 0.1,
+            cpuTimePerPass: 2,
+            rowsWrittenPerPass: 20_000,
+        )
+
+        /// For work that must be finished promptly.
+        public static let prompt = Budget(
+            writeLockDuration: 0.1,
+            pauseBetweenSlices: 0,
+        )
+    }
+
+    public enum StepResult {
+        case more
+        case done
+    }
+
+    public typealias Histogram = DatabaseTransactionMetrics.Histogram
+
+    public struct TaskCost {
+        /// Passes of ``runDueTasks()`` (or calls to
+        /// ``runUntilDone(name:budget:step:)``) that ran the task.
+        public fileprivate(set) var runCount = 0
+        /// Passes that stopped because the task used up its budget.
+        public fileprivate(set) var overBudgetCount = 0
+        public fileprivate(set) var stepCount = 0
+        /// CPU time spent in steps.
+        public fileprivate(set) var cpuMicros: UInt64 = 0
+        /// Rows inserted, updated or deleted by steps, including rows touched
+        /// by triggers.
+        public fileprivate(set) var rowsWritten = 0
+        /// Microseconds each slice held the write lock.
+        public fileprivate(set) var sliceMicros = Histogram()
+        /// Microseconds each slice waited for the write lock.
+        public fileprivate(set) var waitMicros = Histogram()
+    }
+
+    private struct RegisteredTask {
+        let uniqueKey: Cron.UniqueKey
+        let approximateInterval: TimeInterval
+        let budget: Budget
+        let step: (DBWriteTransaction) throws -> StepResult
+    }
+
+    private enum SlicesOutcome {
+        case finished
+        case outOfBudget
+        case cancelled
+    }
+
+    private struct SliceResult {
+        var stepResult: StepResult
+        var stepCount = 0
+        var cpuNanos: UInt64 = 0
+        var rowsWritten = 0
+    }
+
+    private let db: any DB
+    private let maxPauseBetweenSlices: TimeInterval
+    private let tasks = AtomicValue<[RegisteredTask]>([], lock: .init())
+    private let isRunningDueTasks = AtomicBool(false, lock: .init())
+    private let _costs = TSMutex(initialState: [String: TaskCost]())
+
+    init(db: any DB, maxPauseBetweenSlices: TimeInterval = 2) {
+        self.db = db
+        self.maxPauseBetweenSlices = maxPauseBetweenSlices
+    }
+
+    /// Registers a task to be run by ``runDueTasks()`` every
+    /// `approximateInterval` or so.
+    ///
+    /// As with ``Cron/schedulePeriodically(uniqueKey:approximateInterval:mustBeRegistered:mustBeDeviceType:mustBeConnected:isRetryable:operation:)``,
+    /// the time the task last finished is stored under `uniqueKey` (with
+    /// jitter), and tasks run again after the app's version changes. A task
+    /// that runs out of budget hasn't finished, so it runs again in the next
+    /// pass. A task whose step throws is treated as finished and isn't run
+    /// again until `approximateInterval` has passed.
+    public func register(
+        uniqueKey: Cron.UniqueKey,
+        approximateInterval: TimeInterval,
+        budget: Budget = .idle,
+        step: @escaping (DBWriteTransaction) throws -> StepResult,
+    ) {
+        tasks.update {
+            $0.append(RegisteredTask(
+                uniqueKey: uniqueKey,
+                approximateInterval: approximateInterval,
+                budget: budget,
+                step: step,
+            ))
+        }
+    }
+
+    /// Runs each registered task that is due, one at a time, until it's done
+    /// or out of budget.
+    ///
+    /// If the calling task is cancelled (eg because background time is
+    /// running out), the pass stops before the next slice; unfinished tasks
+    /// continue from where they left off in the next pass.
+    public func runDueTasks() async {
+        // Overlapping passes would compete with each other for the lock.
+        guard isRunningDueTasks.tryToSetFlag() else {
+            return
+        }
+        defer { isRunningDueTasks.set(false) }
+
+        for task in tasks.get() {
+            if Task.isCancelled {
+                return
+            }
+            let store = CronStore(uniqueKey: task.uniqueKey)
+            let mostRecentDate = db.read(block: store.mostRecentDate(tx:))
+            if Date() < mostRecentDate.addingTimeInterval(task.approximateInterval) {
+                continue
+            }
+            let outcome: SlicesOutcome
+            do {
+                outcome = try await runSlices(name: task.uniqueKey.rawValue, budget: task.budget, isPass: true, step: task.step)
+            } catch is CancellationError {
+                return
+            } catch {
+                Logger.warn("Maintenance task \(task.uniqueKey) failed: \(error)")
+                outcome = .finished
+            }
+            switch outcome {
+            case .cancelled:
+                return
+            case .outOfBudget:
+                continue
+            case .finished:
+                break
+            }
+            await db.awaitableWrite { tx in
+                store.setMostRecentDate(Date(), jitter: task.approximateInterval / Cron.jitterFactor, tx: tx)
+            }
+        }
+    }
+
+    /// Runs `step` in slices until it returns `.done` (or throws).
+    ///
+    /// Callers rely on the work being finished, so this runs to completion
+    /// even if the calling task is cancelled.
+    public func runUntilDone<E>(
+        name: String,
+        budget: Budget = .prompt,
+        step: (DBWriteTransaction) throws(E) -> StepResult,
+    ) async throws(E) {
+        _ = try await runSlices(name: name, budget: budget, isPass: false, step: step)
+    }
+
+    /// The cost of each task so far, by task name.
+    public func costs() -> [String: TaskCost] {
+        return _costs.withLock { $0 }
+    }
+
+    /// - Parameter isPass: Whether this is a pass of ``runDueTasks()``, which
+    /// is limited by the budget's per-pass limits and stops when cancelled.
+    private func runSlices<E>(
+        name: String,
+        budget: Budget,
+        isPass: Bool,
+        step: (DBWriteTransaction) throws(E) -> StepResult,
+    ) async throws(E) -> SlicesOutcome {
+        var cpuNanos: UInt64 = 0
+        var rowsWritten = 0
+        var pauseBetweenSlices = budget.pauseBetweenSlices
+        var sliceCount = 0
+        _costs.withLock { $0[name, default: TaskCost()].runCount += 1 }
+
+        while true {
+            if isPass, Task.isCancelled {
+                Logger.info("Maintenance task \(name) was cancelled after \(sliceCount) slices; will continue later")
+                return .cancelled
+            }
+            let requestDate = MonotonicDate()
+            var waitDuration = MonotonicDuration(nanoseconds: 0)
+            let sliceResult = try await db.awaitableWrite { tx throws(E) -> SliceResult in
+                let startDate = MonotonicDate()
+                waitDuration = startDate - requestDate
+                let changesCountBefore = tx.database.totalChangesCount
+                let cpuNanosBefore = clock_gettime_nsec_np(CLOCK_THREAD_CPUTIME_ID)
+                var sliceResult = SliceResult(stepResult: .more)
+                func measureSlice() -> SliceResult {
+                    sliceResult.cpuNanos = clock_gettime_nsec_np(CLOCK_THREAD_CPUTIME_ID) - cpuNanosBefore
+                    sliceResult.rowsWritten = tx.database.totalChangesCount - changesCountBefore
+                    recordSlice(name: name, sliceResult: sliceResult, sliceDuration: MonotonicDate() - startDate, waitDuration: waitDuration)
+                    return sliceResult
+                }
+                do throws(E) {
+                    repeat {
+                        sliceResult.stepResult = try autoreleasepool { () throws(E) -> StepResult in
+                            return try step(tx)
+                        }
+                        sliceResult.stepCount += 1
+                    } while sliceResult.stepResult == .more && (MonotonicDate() - startDate).seconds < budget.writeLockDuration
+                } catch {
+                    _ = measureSlice()
+                    throw error
+                }
+                return measureSlice()
+            }
+            sliceCount += 1
+
+            if sliceResult.stepResult == .done {
+                return .finished
+            }
+
+            cpuNanos += sliceResult.cpuNanos
+            rowsWritten += sliceResult.rowsWritten
+            if
+                isPass,
+                (budget.cpuTimePerPass.map { cpuNanos >= $0.clampedNanoseconds } ?? false)
+                    || (budget.rowsWrittenPerPass.map { rowsWritten >= $0 } ?? false)
+            {
+                _costs.withLock { $0[name, default: TaskCost()].overBudgetCount += 1 }
+                Logger.info("Maintenance task \(name) is out of budget after \(sliceCount) slices; will continue later")
+                return .outOfBudget
+            }
+
+            // Waiting for the lock means someone else wants it, so back off.
+            if waitDuration.seconds > budget.writeLockDuration {
+                pauseBetweenSlices = min(max(2 * pauseBetweenSlices, budget.writeLockDuration), maxPauseBetweenSlices)
+            } else {
+                pauseBetweenSlices = budget.pauseBetweenSlices
+            }
+            if pauseBetweenSlices > 0 {
+                do {
+                    try await Task.sleep(nanoseconds: pauseBetweenSlices.clampedNanoseconds)
+                } catch {
+                    // Cancelled; a pass stops at the top of the loop, and
+                    // anything else carries on without pausing.
+                }
+            }
+        }
+    }
+
+    private func recordSlice(name: String, sliceResult: SliceResult, sliceDuration: MonotonicDuration, waitDuration: MonotonicDuration) {
+        _costs.withLock {
+            var cost = $0[name, default: TaskCost()]
+            cost.stepCount += sliceResult.stepCount
+            cost.cpuMicros += sliceResult.cpuNanos / NSEC_PER_USEC
+            cost.rowsWritten += sliceResult.rowsWritten
+            cost.sliceMicros.record(sliceDuration.nanoseconds / NSEC_PER_USEC)
+            cost.waitMicros.record(waitDuration.nanoseconds / NSEC_PER_USEC)
+            $0[name] = cost
+        }
+    }
+}
@@ -0,0 +1,166 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Limits how many message sends run at once across all conversations, with
+/// a separate budget for each kind of traffic, so that (for example) media
+/// sends in one chat can't hold up text sends in others.
+///
+/// A send that can't start waits for a slot in its lane. When a slot frees
+/// up, it goes to a waiter from the conversation with the fewest sends
+/// running in that lane and, among those, to the one that has been ready
+/// the longest. Sends hold a slot only while attempting to send; a send
+/// waiting to be retried gives up its slot and asks for another once its
+/// backoff ends, so retries are served in the order their deadlines passed.
+///
+/// Each lane keeps a histogram of how long sends waited for a slot. When a
+/// lane goes idle after sends had to wait, it logs how long they waited.
+final class MessageSendLaneScheduler {
+
+    enum Lane: CaseIterable, CustomStringConvertible {
+        case text
+        case media
+        case sync
+
+        var description: String {
+            switch self {
+            case .text: return "text"
+            case .media: return "media"
+            case .sync: return "sync"
+            }
+        }
+    }
+
+    typealias Histogram = DatabaseTransactionMetrics.Histogram
+
+    private struct Waiter {
+        let conversationId: String?
+        let readyDate: MonotonicDate
+        let continuation: CheckedContinuation<Void, Never>
+    }
+
+    private struct LaneState {
+        let slotCount: Int
+        var availableSlotCount: Int
+        var activeCountByConversationId = [String?: Int]()
+        var waiters = [Waiter]()
+        /// Microseconds each send waited for a slot.
+        var waitMicros = Histogram()
+        /// Microseconds each send waited since the lane was last idle.
+        var busyPeriodWaitMicros = Histogram()
+        /// Whether any send has had to wait since the lane was last idle.
+        var didQueueInBusyPeriod = false
+
+        init(slotCount: Int) {
+            self.slotCount = slotCount
+            self.availableSlotCount = slotCount
+        }
+
+        mutating func takeSlot(conversationId: String?, readyDate: MonotonicDate) {
+            activeCountByConversationId[conversationId, default: 0] += 1
+            let waitMicros = (MonotonicDate() - readyDate).nanoseconds / NSEC_PER_USEC
+            self.waitMicros.record(waitMicros)
+            busyPeriodWaitMicros.record(waitMicros)
+        }
+
+        mutating func returnSlot(conversationId: String?) {
+            let activeCount = activeCountByConversationId[conversationId, default: 0] - 1
+            activeCountByConversationId[conversationId] = activeCount > 0 ? activeCount : nil
+        }
+
+        /// The waiter whose conversation has the fewest active sends, then the
+        /// one that has been ready the longest.
+        mutating func removeNextWaiter() -> Waiter? {
+            let nextIndex = waiters.indices.min { lhs, rhs in
+                let lhsActiveCount = activeCountByConversationId[waiters[lhs].conversationId, default: 0]
+                let rhsActiveCount = activeCountByConversationId[waiters[rhs].conversationId, default: 0]
+                if lhsActiveCount != rhsActiveCount {
+                    return lhsActiveCount < rhsActiveCount
+                }
+                return waiters[lhs].readyDate < waiters[rhs].readyDate
+            }
+            return nextIndex.map { waiters.remove(at: $0) }
+        }
+    }
+
+    private let lanes: TSMutex<[Lane: LaneState]>
+
+    init(slotCounts: [Lane: Int] = [.text: 16, .media: 3, .sync: 8]) {
+        owsPrecondition(Lane.allCases.allSatisfy { (slotCounts[$0] ?? 0) > 0 })
+        self.lanes = TSMutex(initialState: slotCounts.mapValues { LaneState(slotCount: $0) })
+    }
+
+    /// Runs `operation` once `lane` has a slot for it.
+    func run<T>(
+        lane: Lane,
+        conversationId: String?,
+        operation: () async throws -> T,
+    ) async rethrows -> T {
+        await acquireSlot(lane: lane, conversationId: conversationId)
+        defer { releaseSlot(lane: lane, conversationId: conversationId) }
+        return try await operation()
+    }
+
+    /// How long sends have waited for a slot, by lane.
+    func queueLatencies() -> [Lane: Histogram] {
+        return lanes.withLock { $0.mapValues(\.waitMicros) }
+    }
+
+#if TESTABLE_BUILD
+    func waiterCount(lane: Lane) -> Int {
+        return lanes.withLock { $0[lane]!.waiters.count }
+    }
+#endif
+
+    private func acquireSlot(lane: Lane, conversationId: String?) async {
+        let readyDate = MonotonicDate()
+        await withCheckedContinuation { continuation in
+            let hasSlot = lanes.withLock { lanes in
+                // Released slots go straight to waiters, so there are only
+                // waiters when there are no slots.
+                guard lanes[lane]!.availableSlotCount > 0 else {
+                    lanes[lane]!.didQueueInBusyPeriod = true
+                    lanes[lane]!.waiters.append(Waiter(
+                        conversationId: conversationId,
+                        readyDate: readyDate,
+                        continuation: continuation,
+                    ))
+                    return false
+                }
+                lanes[lane]!.availableSlotCount -= 1
+                lanes[lane]!.takeSlot(conversationId: conversationId, readyDate: readyDate)
+                return true
+            }
+            if hasSlot {
+                continuation.resume()
+            }
+        }
+    }
+
+    private func releaseSlot(lane: Lane, conversationId: String?) {
+        var busyPeriodWaitMicros: Histogram?
+        let nextWaiter = lanes.withLock { lanes -> Waiter? in
+            lanes[lane]!.returnSlot(conversationId: conversationId)
+            guard let nextWaiter = lanes[lane]!.removeNextWaiter() else {
+                lanes[lane]!.availableSlotCount += 1
+                if lanes[lane]!.availableSlotCount == lanes[lane]!.slotCount {
+                    if lanes[lane]!.didQueueInBusyPeriod {
+                        busyPeriodWaitMicros = lanes[lane]!.busyPeriodWaitMicros
+                    }
+                    lanes[lane]!.busyPeriodWaitMicros = Histogram()
+                    lanes[lane]!.didQueueInBusyPeriod = false
+                }
+                return nil
+            }
+            lanes[lane]!.takeSlot(conversationId: nextWaiter.conversationId, readyDate: nextWaiter.readyDate)
+            return nextWaiter
+        }
+        nextWaiter?.continuation.resume()
+        if let busyPeriodWaitMicros {
+            Logger.info("Drained \(lane) lane after \(busyPeriodWaitMicros.count) sends; waits p50=\(busyPeriodWaitMicros.percentile(0.5))us p99=\(busyPeriodWaitMicros.percentile(0.99))us max=\(busyPeriodWaitMicros.max)us")
+        }
+    }
+}
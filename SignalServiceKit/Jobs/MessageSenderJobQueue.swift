@@ -33,7 +33,16 @@ import LibSignalClient
 public class MessageSenderJobQueue {
     private var jobSerializer = CompletionSerializer()
 
-    public init(appReadiness: AppReadiness) {
+    /// Limits concurrent send attempts across all conversations.
+    let laneScheduler = MessageSendLaneScheduler()
+
+    /// Shares transactions between the bookkeeping writes of concurrent jobs
+    /// (recording failures, removing finished jobs), which come in bursts when
+    /// many receipts or sync messages are sent at once.
+    private let jobRecordWriter: CoalescingDatabaseWriter
+
+    public init(appReadiness: AppReadiness, db: any DB) {
+        self.jobRecordWriter = CoalescingDatabaseWriter(db: db)
         appReadiness.runNowOrWhenAppDidBecomeReadyAsync {
             self.setUp()
         }
@@ -462,7 +471,7 @@ public class MessageSenderJobQueue {
     /// the job record has been deleted.
     private func runOperation(_ operation: ActiveOperationState) async {
         let result = await Result { try await self._runOperation(operation) }
-        await SSKEnvironment.shared.databaseStorageRef.awaitableWrite { tx in
+        await jobRecordWriter.write { tx in
             if !operation.job.isInMemoryOnly {
                 operation.job.record.anyRemove(transaction: tx)
             }
@@ -497,10 +506,21 @@ public class MessageSenderJobQueue {
     private func _runOperation(_ operation: ActiveOperationState) async throws {
         var attemptCount = Int(operation.job.record.failureCount)
         let maxRetries = getMaxRetriesForMessageType(message: operation.message)
+        let lane: MessageSendLaneScheduler.Lane
+        if operation.message.isSyncMessage {
+            lane = .sync
+        } else if operation.job.record.useMediaQueue {
+            lane = .media
+        } else {
+            lane = .text
+        }
         while true {
             assert(!Task.isCancelled, "Cancellation isn't supported.")
             operation.clearExternalRetryTriggers()
-            let result = await DependenciesBridge.shared.messageSender.sendMessage(operation.message)
+            // The lane's slot is only held while sending, not while waiting to retry.
+            let result = await laneScheduler.run(lane: lane, conversationId: operation.job.record.threadId) {
+                return await DependenciesBridge.shared.messageSender.sendMessage(operation.message)
+            }
             let errors: [any Error]
             let arbitraryError: any Error
             switch result {
@@ -564,7 +584,7 @@ public class MessageSenderJobQueue {
             }
             attemptCount += 1
             if !operation.job.isInMemoryOnly {
-                await SSKEnvironment.shared.databaseStorageRef.awaitableWrite { tx in
+                await jobRecordWriter.write { tx in
                     operation.job.record.addFailure(tx: tx)
                 }
             }
@@ -164,7 +164,6 @@ private class SendGiftBadgeJobRunner: JobRunner {
         return await .executeBlockWithDefaultErrorHandler(
             jobRecord: jobRecord,
             retryLimit: Constants.maxRetries,
-            db: DependenciesBridge.shared.db,
             block: { try await _runJobAttempt(jobRecord) },
         )
     }
@@ -21,7 +21,15 @@ public class AudioWaveform: Equatable {
 
     // MARK: - Caching
 
+    /// Starts archives in the compact format. Older archives are keyed
+    /// archives, which start with "bplist".
+    private static let compactArchivePrefix = Data([0x57, 0x46, 0x01]) // "WF", version 1
+
     public init(archivedData: Data) throws {
+        if archivedData.starts(with: Self.compactArchivePrefix) {
+            decibelSamples = archivedData.dropFirst(Self.compactArchivePrefix.count).map(Self.decibels(fromLevel:))
+            return
+        }
         let unarchivedSamples = try NSKeyedUnarchiver.unarchivedArrayOfObjects(ofClass: NSNumber.self, from: archivedData)
         guard let unarchivedSamples else {
             throw OWSAssertionError("Failed to unarchive decibel samples")
@@ -30,9 +38,37 @@ public class AudioWaveform: Equatable {
     }
 
     public func archive() throws -> Data {
+        if BuildFlags.writeCompactAudioWaveforms {
+            return archiveCompact()
+        }
+        return try archiveKeyed()
+    }
+
+    func archiveKeyed() throws -> Data {
         return try NSKeyedArchiver.archivedData(withRootObject: decibelSamples, requiringSecureCoding: true)
     }
 
+    /// Archives the samples quantized to a byte each: 256 levels between
+    /// `silenceThreshold` and 0 dB, about 0.2 dB apart, which is much finer
+    /// than we can render.
+    func archiveCompact() -> Data {
+        var result = Self.compactArchivePrefix
+        result.append(contentsOf: decibelSamples.map(Self.level(fromDecibels:)))
+        return result
+    }
+
+    private static func level(fromDecibels decibels: Float) -> UInt8 {
+        guard !decibels.isNaN else {
+            return 0
+        }
+        let fraction = decibels.inverseLerp(AudioWaveform.silenceThreshold, 0, shouldClamp: true)
+        return UInt8((fraction * Float(UInt8.max)).rounded())
+    }
+
+    private static func decibels(fromLevel level: UInt8) -> Float {
+        return (Float(level) / Float(UInt8.max)).lerp(AudioWaveform.silenceThreshold, 0)
+    }
+
     public func write(toFile filePath: String, atomically: Bool) throws {
         try archive().write(to: URL(fileURLWithPath: filePath), options: atomically ? .atomicWrite : .init())
     }
@@ -13,6 +13,13 @@ public protocol AudioWaveformManager {
         attachmentStream: AttachmentStream,
     ) -> Task<AudioWaveform, Error>
 
+    /// Loads the cached waveforms of attachments that are about to be
+    /// rendered, at a lower priority than `cachedAudioWaveform`, so they're
+    /// already in memory when they're needed.
+    func prefetchCachedAudioWaveforms(
+        attachmentStreams: [AttachmentStream],
+    )
+
     func computeAndCacheAudioWaveform(
         audioPath: String,
         cacheWaveformToPath waveformPath: String,
@@ -56,21 +63,65 @@ class AudioWaveformManagerImpl: AudioWaveformManager {
             }
         }
 
+        if let waveform = cachedWaveformCache.get(key: attachmentStream.id) {
+            return Task { waveform }
+        }
+
+        // Reads are cheap next to computing a waveform, so they don't wait
+        // behind computations in `highPriorityTaskQueue`.
         return Task {
-            let fileURL = AttachmentStream.absoluteAttachmentFileURL(
+            return try self.readCachedAudioWaveform(
+                attachmentStream: attachmentStream,
                 relativeFilePath: audioWaveformRelativeFilePath,
             )
-            // waveform is validated at creation time; no need to revalidate every read.
-            let data = try Cryptography.decryptFileWithoutValidating(
-                at: fileURL,
-                metadata: DecryptionMetadata(key: AttachmentKey(
-                    combinedKey: attachmentStream.attachment.encryptionKey,
-                )),
-            )
-            return try AudioWaveform(archivedData: data)
         }
     }
 
+    func prefetchCachedAudioWaveforms(
+        attachmentStreams: [AttachmentStream],
+    ) {
+        for attachmentStream in attachmentStreams {
+            guard
+                attachmentStream.contentType.isAudio,
+                let audioWaveformRelativeFilePath = attachmentStream.cachedAudioWaveformRelativeFilePath,
+                cachedWaveformCache.get(key: attachmentStream.id) == nil
+            else {
+                continue
+            }
+            Task {
+                _ = try? await self.prefetchTaskQueue.run {
+                    try self.readCachedAudioWaveform(
+                        attachmentStream: attachmentStream,
+                        relativeFilePath: audioWaveformRelativeFilePath,
+                    )
+                }
+            }
+        }
+    }
+
+    private func readCachedAudioWaveform(
+        attachmentStream: AttachmentStream,
+        relativeFilePath: String,
+    ) throws -> AudioWaveform {
+        // It may have been loaded while we were waiting in the queue.
+        if let waveform = cachedWaveformCache.get(key: attachmentStream.id) {
+            return waveform
+        }
+        let fileURL = AttachmentStream.absoluteAttachmentFileURL(
+            relativeFilePath: relativeFilePath,
+        )
+        // waveform is validated at creation time; no need to revalidate every read.
+        let data = try Cryptography.decryptFileWithoutValidating(
+            at: fileURL,
+            metadata: DecryptionMetadata(key: AttachmentKey(
+                combinedKey: attachmentStream.attachment.encryptionKey,
+            )),
+        )
+        let waveform = try AudioWaveform(archivedData: data)
+        cachedWaveformCache.set(key: attachmentStream.id, value: waveform)
+        return waveform
+    }
+
     func computeAndCacheAudioWaveform(
         audioPath: String,
         cacheWaveformToPath: String,
@@ -138,8 +189,15 @@ class AudioWaveformManagerImpl: AudioWaveformManager {
     private let taskQueue = ConcurrentTaskQueue(concurrentLimit: 1)
     private let highPriorityTaskQueue = ConcurrentTaskQueue(concurrentLimit: 1)
 
+    private let prefetchTaskQueue = ConcurrentTaskQueue(concurrentLimit: 2)
+
     private var cache = LRUCache<Attachment.IDType, Weak<AudioWaveform>>(maxSize: 64)
 
+    /// Waveforms read from attachments' waveform files, so rendering the same
+    /// attachment again (e.g. when scrolling back) doesn't re-read them.
+    /// They're about a hundred bytes each, so we can keep plenty.
+    private let cachedWaveformCache = LRUCache<Attachment.IDType, AudioWaveform>(maxSize: 512)
+
     private func buildAudioWaveForm(
         source: AVAssetSource,
         cacheWaveformToPath: String,
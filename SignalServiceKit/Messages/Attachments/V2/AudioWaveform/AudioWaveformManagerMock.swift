@@ -17,6 +17,8 @@ public class AudioWaveformManagerMock: AudioWaveformManager {
         }
     }
 
+    public func prefetchCachedAudioWaveforms(attachmentStreams: [AttachmentStream]) {}
+
     public func computeAndCacheAudioWaveform(audioPath: String, cacheWaveformToPath waveformPath: String) -> Task<AudioWaveform, any Error> {
         return Task {
             return AudioWaveform(decibelSamples: [])
@@ -3,7 +3,6 @@
 // SPDX-License-Identifier: AGPL-3.0-only
 //
 
-import Accelerate
 import Foundation
 
 class AudioWaveformSampler {
@@ -31,7 +30,6 @@ class AudioWaveformSampler {
     /// evenly divide inputCount).
     private var overflowCounter: Int
 
-    private var buffer = [Float]()
     private var output = [Float]()
 
     init(inputCount: Int, outputCount: Int) {
@@ -59,72 +57,109 @@ class AudioWaveformSampler {
     }
 
     func update(_ samples: UnsafeBufferPointer<Int16>) {
-        let sampleCount = samples.count
-        if self.buffer.count < sampleCount {
-            self.buffer.append(contentsOf: Array(repeating: 0, count: sampleCount - self.buffer.count))
+        var remainingCount = samples.count
+        // If a file understates its sample count in its container metadata,
+        // we'll be using a too-short segment length and consequently could
+        // take more samples than we expect. Short-circuit if we've already
+        // taken all the samples we intend to.
+        while
+            remainingCount > 0,
+            !self.isComplete
+        {
+            let chunkCount = min(remainingCount, self.currentSegmentRemainingCount)
+            assert(chunkCount > 0) // because currentSegmentRemainingCount starts > 0 and is checked on each iteration
+            let chunkStart = samples.count - remainingCount
+            let chunkAverage = Self.meanDecibels(UnsafeBufferPointer(rebasing: samples[chunkStart..<(chunkStart + chunkCount)]))
+            remainingCount -= chunkCount
+            self.currentSegmentRemainingCount -= chunkCount
+
+            // Add the new average to the running average for this segment.
+            let totalChunkCount = self.currentSegmentCount - self.currentSegmentRemainingCount
+            assert(totalChunkCount > 0) // because chunkCount > 0
+            let newChunkWeight = Float(chunkCount) / Float(totalChunkCount)
+            let oldChunkWeight = 1 - newChunkWeight
+            self.currentSegmentAverage *= oldChunkWeight
+            self.currentSegmentAverage += chunkAverage * newChunkWeight
+
+            // If we reached the end of the chunk, add it to the output.
+            if self.currentSegmentRemainingCount <= 0 {
+                self.output.append(self.currentSegmentAverage)
+                self.currentSegmentAverage = 0 // technically redundant
+
+                self.currentSegmentCount = self.segmentLength
+                self.overflowCounter -= self.segmentRemainder
+                if self.overflowCounter <= 0 {
+                    self.currentSegmentCount += 1
+                    self.overflowCounter += self.segmentLength
+                }
+                self.currentSegmentRemainingCount = self.currentSegmentCount
+            }
         }
-
-        // convert UInt16 amplitudes to Float representation
-        vDSP_vflt16(samples.baseAddress!, 1, &self.buffer, 1, vDSP_Length(sampleCount))
-
-        // take the absolute amplitude value
-        vDSP_vabs(self.buffer, 1, &self.buffer, 1, vDSP_Length(sampleCount))
-
-        // convert to dB
-        // maximum amplitude storable in Int16 = 0 dB (loudest)
-        // (remember decibels are often negative)
-        var zeroDecibelEquivalent: Float = Float(Int16.max)
-        vDSP_vdbcon(self.buffer, 1, &zeroDecibelEquivalent, &self.buffer, 1, vDSP_Length(sampleCount), 1)
-
-        // clip between loudest + quietest
-        var loudestClipValue: Float = 0.0
-        var quietestClipValue = AudioWaveform.silenceThreshold
-        vDSP_vclip(self.buffer, 1, &quietestClipValue, &loudestClipValue, &self.buffer, 1, vDSP_Length(sampleCount))
-
-        self.reduce(sampleCount: sampleCount)
     }
 
-    private func reduce(sampleCount: Int) {
-        self.buffer.withUnsafeBufferPointer { bufferPtr in
-            var remainingCount = sampleCount
-            // If a file understates its sample count in its container metadata,
-            // we'll be using a too-short segment length and consequently could
-            // take more samples than we expect. Short-circuit if we've already
-            // taken all the samples we intend to.
-            while
-                remainingCount > 0,
-                !self.isComplete
-            {
-                let chunkCount = min(remainingCount, self.currentSegmentRemainingCount)
-                assert(chunkCount > 0) // because currentSegmentRemainingCount starts > 0 and is checked on each iteration
-                var chunkAverage: Float = 0
-                vDSP_meanv(bufferPtr.baseAddress!.advanced(by: sampleCount - remainingCount), 1, &chunkAverage, vDSP_Length(chunkCount))
-                remainingCount -= chunkCount
-                self.currentSegmentRemainingCount -= chunkCount
-
-                // Add the new average to the running average for this segment.
-                let totalChunkCount = self.currentSegmentCount - self.currentSegmentRemainingCount
-                assert(totalChunkCount > 0) // because chunkCount > 0
-                let newChunkWeight = Float(chunkCount) / Float(totalChunkCount)
-                let oldChunkWeight = 1 - newChunkWeight
-                self.currentSegmentAverage *= oldChunkWeight
-                self.currentSegmentAverage += chunkAverage * newChunkWeight
-
-                // If we reached the end of the chunk, add it to the output.
-                if self.currentSegmentRemainingCount <= 0 {
-                    self.output.append(self.currentSegmentAverage)
-                    self.currentSegmentAverage = 0 // technically redundant
-
-                    self.currentSegmentCount = self.segmentLength
-                    self.overflowCounter -= self.segmentRemainder
-                    if self.overflowCounter <= 0 {
-                        self.currentSegmentCount += 1
-                        self.overflowCounter += self.segmentLength
-                    }
-                    self.currentSegmentRemainingCount = self.currentSegmentCount
-                }
+    // MARK: - Decibels
+
+    private typealias Lanes = SIMD8<Float>
+
+    /// The amplitude at `AudioWaveform.silenceThreshold`. Anything quieter is
+    /// clipped to the threshold.
+    private static let quietestAmplitude = Float(Int16.max) * pow(10, AudioWaveform.silenceThreshold / 20)
+    private static let loudestAmplitude = Float(Int16.max)
+
+    /// How many samples each lane multiplies together before being
+    /// renormalized. Clipped amplitudes are less than 2^15, so eight of them
+    /// times a mantissa less than 2 stays well within `Float`'s range.
+    private static let renormalizeInterval = 8
+
+    /// Returns the mean of the samples' loudness in decibels.
+    ///
+    /// Each sample's loudness is `20 * log10(|sample| / Int16.max)`, clipped
+    /// between `AudioWaveform.silenceThreshold` (quietest) and 0 (loudest).
+    /// That's monotonic in the amplitude, so clipping the amplitude first is
+    /// equivalent. And the mean of logarithms is the logarithm of the product,
+    /// so this makes a single pass that multiplies clipped amplitudes together
+    /// in SIMD lanes, tracking each lane's exponent separately so the product
+    /// can't overflow, and only takes logarithms at the end.
+    static func meanDecibels(_ samples: UnsafeBufferPointer<Int16>) -> Float {
+        guard let baseAddress = samples.baseAddress, !samples.isEmpty else {
+            return AudioWaveform.silenceThreshold
+        }
+        let quietest = Lanes(repeating: quietestAmplitude)
+        let loudest = Lanes(repeating: loudestAmplitude)
+
+        // The product of each lane's amplitudes is mantissas * 2^exponents.
+        var mantissas = Lanes(repeating: 1)
+        var exponents = SIMD8<Int32>(repeating: 0)
+
+        let blockLength = Lanes.scalarCount * renormalizeInterval
+        var index = 0
+        while index + blockLength <= samples.count {
+            for _ in 0..<renormalizeInterval {
+                let rawSamples = UnsafeRawPointer(baseAddress + index).loadUnaligned(as: SIMD8<Int16>.self)
+                let amplitudes = Lanes(rawSamples)
+                mantissas *= pointwiseMax(amplitudes, -amplitudes).clamped(lowerBound: quietest, upperBound: loudest)
+                index += Lanes.scalarCount
             }
+            // Move the exponent out of each (positive, normal) product,
+            // leaving a mantissa in [1, 2).
+            let bits = unsafeBitCast(mantissas, to: SIMD8<UInt32>.self)
+            exponents &+= SIMD8<Int32>(truncatingIfNeeded: (bits &>> 23) & 0xff) &- 127
+            mantissas = unsafeBitCast((bits & 0x007f_ffff) | 0x3f80_0000, to: Lanes.self)
+        }
+
+        var log2Sum = Double(exponents.wrappedSum())
+        for lane in 0..<Lanes.scalarCount {
+            log2Sum += log2(Double(mantissas[lane]))
+        }
+        while index < samples.count {
+            let amplitude = min(max(abs(Float(samples[index])), quietestAmplitude), loudestAmplitude)
+            log2Sum += log2(Double(amplitude))
+            index += 1
         }
+
+        // 20 * log10(x / Int16.max) == 20 * log10(2) * log2(x) - 20 * log10(Int16.max)
+        let meanLog2 = log2Sum / Double(samples.count)
+        return Float(20 * log10(2) * meanLog2 - 20 * log10(Double(Int16.max)))
     }
 
     func finalize() -> [Float] {
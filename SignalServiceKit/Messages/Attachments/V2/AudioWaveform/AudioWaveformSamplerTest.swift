@@ -3,6 +3,9 @@
 // SPDX-License-Identifier: AGPL-3.0-only
 //
 
+#if canImport(Accelerate)
+import Accelerate
+#endif
 import Foundation
 import XCTest
 
@@ -73,6 +76,70 @@ final class AudioWaveformSamplerTest: XCTestCase {
             XCTAssertEqual(sampler.finalize().count, testCase.outputCount)
         }
     }
+
+    func testMeanDecibelsClipping() {
+        func meanDecibels(_ samples: [Int16]) -> Float {
+            return samples.withUnsafeBufferPointer(AudioWaveformSampler.meanDecibels)
+        }
+        // Enough samples to fill the SIMD lanes, plus a few left over.
+        XCTAssertEqual(meanDecibels(Array(repeating: 0, count: 100)), AudioWaveform.silenceThreshold, accuracy: 0.0001)
+        XCTAssertEqual(meanDecibels(Array(repeating: .max, count: 100)), 0, accuracy: 0.0001)
+        XCTAssertEqual(meanDecibels(Array(repeating: .min, count: 100)), 0, accuracy: 0.0001)
+        XCTAssertEqual(meanDecibels(Array(repeating: -3_277, count: 100)), -20, accuracy: 0.01)
+        XCTAssertEqual(meanDecibels([0, .max]), AudioWaveform.silenceThreshold / 2, accuracy: 0.0001)
+    }
+
+#if canImport(Accelerate)
+    /// Compares against the separate Accelerate passes this replaced.
+    func testMatchesAccelerate() {
+        func referenceMeanDecibels(_ samples: [Int16]) -> Float {
+            var buffer = [Float](repeating: 0, count: samples.count)
+            vDSP_vflt16(samples, 1, &buffer, 1, vDSP_Length(samples.count))
+            vDSP_vabs(buffer, 1, &buffer, 1, vDSP_Length(samples.count))
+            var zeroDecibelEquivalent = Float(Int16.max)
+            vDSP_vdbcon(buffer, 1, &zeroDecibelEquivalent, &buffer, 1, vDSP_Length(samples.count), 1)
+            var loudestClipValue: Float = 0
+            var quietestClipValue = AudioWaveform.silenceThreshold
+            vDSP_vclip(buffer, 1, &quietestClipValue, &loudestClipValue, &buffer, 1, vDSP_Length(samples.count))
+            var mean: Float = 0
+            vDSP_meanv(buffer, 1, &mean, vDSP_Length(samples.count))
+            return mean
+        }
+
+        for sampleCount in [1, 7, 8, 63, 64, 65, 1_000, 48_000] {
+            let loudSamples = (0..<sampleCount).map { _ in Int16.random(in: .min ... .max) }
+            let quietSamples = (0..<sampleCount).map { _ in Int16.random(in: -200...200) }
+            for samples in [loudSamples, quietSamples] {
+                XCTAssertEqual(
+                    samples.withUnsafeBufferPointer(AudioWaveformSampler.meanDecibels),
+                    referenceMeanDecibels(samples),
+                    accuracy: 0.0001,
+                )
+            }
+        }
+    }
+#endif
+
+    /// Samples an hour of 44.1 kHz audio, as it would be decoded from voice
+    /// notes, in the buffer size AVAssetReader typically returns.
+    func testPerformance() {
+        let bufferLength = 8192
+        let bufferCount = 44_100 * 60 * 60 / bufferLength
+        // Speech-like: a varying tone with noise, and some near silence.
+        let samples: [Int16] = (0..<bufferLength).map { index in
+            let envelope = Float(index % 2048) / 2048
+            let tone = sin(Float(index) * 0.07) * 12_000 * envelope
+            return Int16(tone) &+ Int16.random(in: -300...300)
+        }
+
+        measure {
+            let sampler = AudioWaveformSampler(inputCount: bufferLength * bufferCount, outputCount: AudioWaveform.sampleCount)
+            for _ in 0..<bufferCount {
+                sampler.update(samples)
+            }
+            XCTAssertEqual(sampler.finalize().count, AudioWaveform.sampleCount)
+        }
+    }
 }
 
 private extension AudioWaveformSampler {
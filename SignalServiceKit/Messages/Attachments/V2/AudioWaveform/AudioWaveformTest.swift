@@ -0,0 +1,47 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+final class AudioWaveformTest: XCTestCase {
+    func testArchiveRoundtrip() throws {
+        let decibelSamples: [Float] = (0..<AudioWaveform.sampleCount).map { _ in Float.random(in: AudioWaveform.silenceThreshold...0) }
+        let archivedData = AudioWaveform(decibelSamples: decibelSamples).archiveCompact()
+        XCTAssertLessThanOrEqual(archivedData.count, AudioWaveform.sampleCount + 3)
+
+        let unarchivedLevels = try AudioWaveform(archivedData: archivedData).normalizedLevelsToDisplay(sampleCount: AudioWaveform.sampleCount)
+        let expectedLevels = AudioWaveform(decibelSamples: decibelSamples).normalizedLevelsToDisplay(sampleCount: AudioWaveform.sampleCount)
+        XCTAssertEqual(unarchivedLevels.count, expectedLevels.count)
+        for (unarchivedLevel, expectedLevel) in zip(unarchivedLevels, expectedLevels) {
+            // Quantized to 1/255 of the 50 dB range; the display range is 30 dB.
+            XCTAssertEqual(unarchivedLevel, expectedLevel, accuracy: 0.01)
+        }
+    }
+
+    func testArchiveClipsOutOfRangeSamples() throws {
+        let archivedData = AudioWaveform(decibelSamples: [-80, -.infinity, 3, .nan]).archiveCompact()
+        let waveform = try AudioWaveform(archivedData: archivedData)
+        XCTAssertEqual(waveform, AudioWaveform(decibelSamples: [AudioWaveform.silenceThreshold, AudioWaveform.silenceThreshold, 0, AudioWaveform.silenceThreshold]))
+    }
+
+    func testArchivesKeyedArchiveByDefault() throws {
+        let decibelSamples: [Float] = [-50, -32.5, -20, -1.25]
+        let archivedData = try AudioWaveform(decibelSamples: decibelSamples).archive()
+        // Builds from before the compact format can only read keyed archives.
+        XCTAssertTrue(archivedData.starts(with: Data("bplist".utf8)))
+        let unarchivedSamples = try NSKeyedUnarchiver.unarchivedArrayOfObjects(ofClass: NSNumber.self, from: archivedData)
+        XCTAssertEqual(unarchivedSamples?.map { $0.floatValue }, decibelSamples)
+        XCTAssertEqual(try AudioWaveform(archivedData: archivedData), AudioWaveform(decibelSamples: decibelSamples))
+    }
+
+    func testUnarchivesKeyedArchive() throws {
+        let decibelSamples: [Float] = [-50, -32.5, -20, -1.25]
+        let legacyArchivedData = try NSKeyedArchiver.archivedData(withRootObject: decibelSamples, requiringSecureCoding: true)
+        XCTAssertEqual(try AudioWaveform(archivedData: legacyArchivedData), AudioWaveform(decibelSamples: decibelSamples))
+    }
+}
@@ -1783,7 +1783,27 @@ public class AttachmentDownloadManagerImpl: AttachmentDownloadManager {
             self.signalService = signalService
         }
 
-        private let queue = ConcurrentTaskQueue(concurrentLimit: 12)
+        private let queue = ConcurrentTaskQueue(concurrentLimit: Constants.maxConcurrentDownloads)
+        /// Downloads take a slot for their CDN before taking one in `queue`,
+        /// so a slow CDN can't hold every slot and stall the others.
+        private let cdnQueues = TSMutex<[UInt32: ConcurrentTaskQueue]>(initialState: [:])
+        private let metrics = TSMutex(initialState: Metrics())
+
+        private enum Constants {
+            static let maxConcurrentDownloads = 16
+            static let maxConcurrentDownloadsPerCdn = 12
+        }
+
+        /// Tracks how long downloads wait for a slot, from when the first one
+        /// is enqueued until the queue is idle again.
+        private struct Metrics {
+            var waitingCount = 0
+            var runningCount = 0
+            var maxWaitingCount = 0
+            var startedCount = 0
+            var totalWaitNanoseconds: UInt64 = 0
+            var maxWaitNanoseconds: UInt64 = 0
+        }
 
         /// Fetch the first `length` bytes of the object from the CDN, returning the fetched bytes,
         /// (or nil if the response was empty) alongside headers from the response (which are the
@@ -1815,13 +1835,72 @@ public class AttachmentDownloadManagerImpl: AttachmentDownloadManager {
             maxDownloadSizeBytes: UInt64,
             progressBlock: OWSURLSession.ProgressBlock,
         ) async throws -> URL {
-            return try await queue.run {
-                return try await performDownload(
-                    downloadState: downloadState,
-                    maxDownloadSizeBytes: maxDownloadSizeBytes,
-                    progressBlock: progressBlock,
-                )
+            let cdnQueue = cdnQueues.withLock {
+                if let cdnQueue = $0[downloadState.cdnNumber()] {
+                    return cdnQueue
+                }
+                let cdnQueue = ConcurrentTaskQueue(concurrentLimit: Constants.maxConcurrentDownloadsPerCdn)
+                $0[downloadState.cdnNumber()] = cdnQueue
+                return cdnQueue
+            }
+
+            let enqueueDate = MonotonicDate()
+            didEnqueueDownload()
+            let didStart = AtomicBool(false, lock: .init())
+            defer { didFinishDownload(didStart: didStart.get()) }
+
+            return try await cdnQueue.run {
+                return try await queue.run {
+                    didStart.set(true)
+                    didStartDownload(waitDuration: MonotonicDate() - enqueueDate)
+                    return try await performDownload(
+                        downloadState: downloadState,
+                        maxDownloadSizeBytes: maxDownloadSizeBytes,
+                        progressBlock: progressBlock,
+                    )
+                }
+            }
+        }
+
+        // MARK: Metrics
+
+        private func didEnqueueDownload() {
+            metrics.withLock {
+                $0.waitingCount += 1
+                $0.maxWaitingCount = max($0.maxWaitingCount, $0.waitingCount)
+            }
+        }
+
+        private func didStartDownload(waitDuration: MonotonicDuration) {
+            metrics.withLock {
+                $0.waitingCount -= 1
+                $0.runningCount += 1
+                $0.startedCount += 1
+                $0.totalWaitNanoseconds += waitDuration.nanoseconds
+                $0.maxWaitNanoseconds = max($0.maxWaitNanoseconds, waitDuration.nanoseconds)
+            }
+        }
+
+        private func didFinishDownload(didStart: Bool) {
+            let drainedMetrics = metrics.withLock { metrics -> Metrics? in
+                if didStart {
+                    metrics.runningCount -= 1
+                } else {
+                    // Canceled while waiting.
+                    metrics.waitingCount -= 1
+                }
+                guard metrics.waitingCount == 0, metrics.runningCount == 0 else {
+                    return nil
+                }
+                defer { metrics = Metrics() }
+                return metrics
+            }
+            guard let drainedMetrics, drainedMetrics.startedCount > 0 else {
+                return
             }
+            let meanWaitMs = drainedMetrics.totalWaitNanoseconds / UInt64(drainedMetrics.startedCount) / NSEC_PER_MSEC
+            let maxWaitMs = drainedMetrics.maxWaitNanoseconds / NSEC_PER_MSEC
+            Logger.info("Drained: \(drainedMetrics.startedCount) downloads, at most \(drainedMetrics.maxWaitingCount) waiting; waited \(meanWaitMs)ms on average, \(maxWaitMs)ms at most")
         }
 
         @concurrent
@@ -0,0 +1,213 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import GRDB
+
+/// An in-memory copy of the ``QueuedAttachmentDownloadRecord`` table, kept in
+/// the orders the download queue is read in, so that deciding what to download
+/// next doesn't have to query the database.
+///
+/// Ready downloads are ordered by priority (highest first) and then insertion
+/// order; downloads waiting to retry are ordered by retry timestamp and then
+/// insertion order.
+///
+/// The index observes every change to the table, including rows deleted when
+/// their attachment is deleted, and re-reads the changed rows when the
+/// transaction commits. Writes are serialized, so the first such commit is also
+/// when the whole table is loaded. Until then, and while a transaction that
+/// changed the table is still open, lookups return nil and callers should
+/// query the database instead.
+///
+/// - Important
+/// Writes from other processes aren't observed. Only the main app hears about
+/// them (and drops the index when it does), so only the main app should use one.
+final class AttachmentDownloadQueueIndex: TransactionObserver {
+
+    typealias Record = QueuedAttachmentDownloadRecord
+
+    struct Summary: Equatable {
+        /// Downloads that can start now.
+        let readyCount: Int
+        /// Downloads waiting for their retry timestamp.
+        let retryingCount: Int
+        /// The lowest retry timestamp, if any download is waiting to retry.
+        let nextRetryTimestamp: UInt64?
+    }
+
+    fileprivate struct State {
+        var isLoaded = false
+        /// Whether an open transaction has changed the table.
+        var hasUncommittedChanges = false
+        var records = [Record.IDType: Record]()
+        /// Records with no retry timestamp, by descending priority then id.
+        var ready = [Record]()
+        /// Records with a retry timestamp, by ascending timestamp then id.
+        var retrying = [Record]()
+    }
+
+    private let state = TSMutex(initialState: State())
+
+    /// Rows changed by the open write transaction. Only touched from the
+    /// observer callbacks, which the database serializes.
+    private var changedRowIds = Set<Record.IDType>()
+
+    init(db: any DB) {
+        db.add(transactionObserver: self, extent: .observerLifetime)
+        NotificationCenter.default.addObserver(
+            forName: SDSDatabaseStorage.didReceiveCrossProcessNotificationAlwaysSync,
+            object: nil,
+            queue: nil,
+        ) { [weak self] _ in
+            self?.didReceiveCrossProcessWrite()
+        }
+    }
+
+    // MARK: - Lookups
+
+    /// The first `count` downloads that can start now, in download order, or
+    /// nil if the index can't answer.
+    func peek(count: UInt) -> [Record]? {
+        return state.withLock { state in
+            guard state.isLoaded, !state.hasUncommittedChanges else {
+                return nil
+            }
+            return Array(state.ready.prefix(Int(clamping: count)))
+        }
+    }
+
+    /// The size of the queue and the next retry timestamp, or nil if the
+    /// index can't answer.
+    func summary() -> Summary? {
+        return state.withLock { state in
+            guard state.isLoaded, !state.hasUncommittedChanges else {
+                return nil
+            }
+            return Summary(
+                readyCount: state.ready.count,
+                retryingCount: state.retrying.count,
+                nextRetryTimestamp: state.retrying.first?.minRetryTimestamp,
+            )
+        }
+    }
+
+    private func didReceiveCrossProcessWrite() {
+        // Another process may have changed the table; reload on our next commit.
+        state.withLock { state in
+            let hasUncommittedChanges = state.hasUncommittedChanges
+            state = State()
+            state.hasUncommittedChanges = hasUncommittedChanges
+        }
+    }
+
+    // MARK: - TransactionObserver
+
+    func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool {
+        return eventKind.tableName == Record.databaseTableName
+    }
+
+    func databaseDidChange(with event: DatabaseEvent) {
+        if changedRowIds.isEmpty {
+            state.withLock { $0.hasUncommittedChanges = true }
+        }
+        changedRowIds.insert(event.rowID)
+    }
+
+    func databaseDidCommit(_ db: Database) {
+        guard !changedRowIds.isEmpty else {
+            return
+        }
+        let rowIds = changedRowIds
+        changedRowIds = []
+
+        // Nothing else can write until we return, so what we read here is
+        // exactly what the next commit will build on.
+        let isLoaded = state.withLock { $0.isLoaded }
+        do {
+            if isLoaded {
+                let changedRecords = try Record.fetchAll(db, keys: rowIds)
+                state.withLock { state in
+                    rowIds.forEach { state.remove(id: $0) }
+                    changedRecords.forEach { state.insert($0) }
+                    state.hasUncommittedChanges = false
+                }
+            } else {
+                let allRecords = try Record.fetchAll(db)
+                state.withLock { state in
+                    state = State()
+                    allRecords.forEach { state.insert($0) }
+                    state.isLoaded = true
+                }
+            }
+        } catch {
+            owsFailDebug("Unable to read queued downloads: \(error.grdbErrorForLogging)")
+            state.withLock { $0 = State() }
+        }
+    }
+
+    func databaseDidRollback(_ db: Database) {
+        changedRowIds = []
+        state.withLock { $0.hasUncommittedChanges = false }
+    }
+}
+
+// MARK: -
+
+extension AttachmentDownloadQueueIndex.State {
+
+    mutating func insert(_ record: Record) {
+        guard let id = record.id else {
+            owsFailDebug("Missing id")
+            return
+        }
+        records[id] = record
+        if record.minRetryTimestamp == nil {
+            ready.insert(record, at: Self.index(of: record, in: ready, by: Self.readyOrder))
+        } else {
+            retrying.insert(record, at: Self.index(of: record, in: retrying, by: Self.retryOrder))
+        }
+    }
+
+    mutating func remove(id: Record.IDType) {
+        guard let record = records.removeValue(forKey: id) else {
+            return
+        }
+        if record.minRetryTimestamp == nil {
+            ready.remove(at: Self.index(of: record, in: ready, by: Self.readyOrder))
+        } else {
+            retrying.remove(at: Self.index(of: record, in: retrying, by: Self.retryOrder))
+        }
+    }
+
+    private static func readyOrder(_ lhs: Record, _ rhs: Record) -> Bool {
+        if lhs.priority != rhs.priority {
+            return lhs.priority.rawValue > rhs.priority.rawValue
+        }
+        return lhs.id! < rhs.id!
+    }
+
+    private static func retryOrder(_ lhs: Record, _ rhs: Record) -> Bool {
+        return (lhs.minRetryTimestamp!, lhs.id!) < (rhs.minRetryTimestamp!, rhs.id!)
+    }
+
+    /// The index of the first element of `sortedRecords` not ordered before
+    /// `record`; that's where it is, if present, or where it belongs.
+    private static func index(
+        of record: Record,
+        in sortedRecords: [Record],
+        by isOrderedBefore: (Record, Record) -> Bool,
+    ) -> Int {
+        var lowerBound = 0
+        var upperBound = sortedRecords.count
+        while lowerBound < upperBound {
+            let midpoint = (lowerBound + upperBound) / 2
+            if isOrderedBefore(sortedRecords[midpoint], record) {
+                lowerBound = midpoint + 1
+            } else {
+                upperBound = midpoint
+            }
+        }
+        return lowerBound
+    }
+}
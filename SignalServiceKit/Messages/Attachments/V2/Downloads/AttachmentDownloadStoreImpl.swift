@@ -8,11 +8,16 @@ import GRDB
 public struct AttachmentDownloadStore {
 
     private let dateProvider: DateProvider
+    private let queueIndex: AttachmentDownloadQueueIndex?
 
-    public init(
+    /// - parameter queueIndex: If provided, answers ``peek(count:tx:)`` and
+    ///     ``nextRetryTimestamp(tx:)`` from memory whenever it can.
+    init(
         dateProvider: @escaping DateProvider,
+        queueIndex: AttachmentDownloadQueueIndex?,
     ) {
         self.dateProvider = dateProvider
+        self.queueIndex = queueIndex
     }
 
     private typealias Record = QueuedAttachmentDownloadRecord
@@ -43,6 +48,10 @@ public struct AttachmentDownloadStore {
         count: UInt,
         tx: DBReadTransaction,
     ) -> [QueuedAttachmentDownloadRecord] {
+        if let records = queueIndex?.peek(count: count) {
+            return records
+        }
+
         let query = QueuedAttachmentDownloadRecord
             .filter(Column(.minRetryTimestamp) == nil)
             .order([Column(.priority).desc, Column(.id).asc])
@@ -55,6 +64,10 @@ public struct AttachmentDownloadStore {
 
     /// Return the lowest non-nil `minRetryTimestamp`.
     public func nextRetryTimestamp(tx: DBReadTransaction) -> UInt64? {
+        if let summary = queueIndex?.summary() {
+            return summary.nextRetryTimestamp
+        }
+
         let query = QueuedAttachmentDownloadRecord
             .filter(Column(.minRetryTimestamp) != nil)
             .select([min(Column(.minRetryTimestamp))], as: UInt64.self)
@@ -165,9 +178,15 @@ public struct AttachmentDownloadStore {
     /// Update all downloads with`minRetryTimestamp` past the current timestamp,
     /// marking them retryable.
     public func updateRetryableDownloads(tx: DBWriteTransaction) {
+        let now = dateProvider().ows_millisecondsSince1970
+        if let summary = queueIndex?.summary(), (summary.nextRetryTimestamp ?? .max) > now {
+            // Nothing is ready to retry yet.
+            return
+        }
+
         let query = QueuedAttachmentDownloadRecord
             .filter(Column(.minRetryTimestamp) != nil)
-            .filter(Column(.minRetryTimestamp) <= dateProvider().ows_millisecondsSince1970)
+            .filter(Column(.minRetryTimestamp) <= now)
 
         failIfThrows {
             try query.updateAll(tx.database, Column(.minRetryTimestamp).set(to: nil))
@@ -182,6 +201,7 @@ public struct AttachmentDownloadStore {
         priority: AttachmentDownloadPriority,
         tx: DBWriteTransaction,
     ) {
+        let originalRecord = record
         if record.priority.rawValue < priority.rawValue {
             record.priority = priority
             record.minRetryTimestamp = nil
@@ -190,6 +210,14 @@ public struct AttachmentDownloadStore {
             record.minRetryTimestamp = nil
         }
 
+        guard
+            record.priority != originalRecord.priority
+            || record.minRetryTimestamp != originalRecord.minRetryTimestamp
+        else {
+            // Re-enqueueing something already queued as-is shouldn't write.
+            return
+        }
+
         failIfThrows {
             try record.update(tx.database)
         }
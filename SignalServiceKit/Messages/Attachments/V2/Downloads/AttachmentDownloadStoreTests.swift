@@ -14,17 +14,27 @@ class AttachmentDownloadStoreTests: XCTestCase {
     private var db: InMemoryDB!
 
     private var attachmentStore: AttachmentStore!
+    private var queueIndex: AttachmentDownloadQueueIndex!
     private var downloadStore: AttachmentDownloadStore!
+    private var unindexedDownloadStore: AttachmentDownloadStore!
 
     private var now = Date()
 
     override func setUp() async throws {
         db = InMemoryDB()
         attachmentStore = AttachmentStore()
+        queueIndex = AttachmentDownloadQueueIndex(db: db)
         downloadStore = AttachmentDownloadStore(
             dateProvider: { [weak self] in
                 return self!.now
             },
+            queueIndex: queueIndex,
+        )
+        unindexedDownloadStore = AttachmentDownloadStore(
+            dateProvider: { [weak self] in
+                return self!.now
+            },
+            queueIndex: nil,
         )
     }
 
@@ -262,6 +272,88 @@ class AttachmentDownloadStoreTests: XCTestCase {
         }
     }
 
+    func testQueueIndex() {
+        self.now = Date(millisecondsSince1970: 0)
+        let attachmentIds = (0..<10).map { _ in insertAttachment() }
+
+        // Nothing has been loaded until a change to the table commits.
+        XCTAssertNil(queueIndex.peek(count: 10))
+
+        for (i, attachmentId) in attachmentIds.enumerated() {
+            db.write { tx in
+                downloadStore.enqueueDownloadOfAttachment(
+                    withId: attachmentId,
+                    source: .transitTier,
+                    priority: i.isMultiple(of: 3) ? .userInitiated : .default,
+                    tx: tx,
+                )
+            }
+        }
+        let downloadIds = db.read { tx in
+            attachmentIds.map { downloadStore.enqueuedDownload(for: $0, tx: tx)!.id! }
+        }
+
+        func assertIndexMatchesDatabase(file: StaticString = #filePath, line: UInt = #line) {
+            XCTAssertNotNil(queueIndex.summary(), file: file, line: line)
+            db.read { tx in
+                XCTAssertEqual(
+                    downloadStore.peek(count: 20, tx: tx).map(\.id),
+                    unindexedDownloadStore.peek(count: 20, tx: tx).map(\.id),
+                    file: file,
+                    line: line,
+                )
+                XCTAssertEqual(
+                    downloadStore.nextRetryTimestamp(tx: tx),
+                    unindexedDownloadStore.nextRetryTimestamp(tx: tx),
+                    file: file,
+                    line: line,
+                )
+            }
+        }
+        assertIndexMatchesDatabase()
+        XCTAssertEqual(queueIndex.summary(), .init(readyCount: 10, retryingCount: 0, nextRetryTimestamp: nil))
+
+        db.write { tx in
+            for i in 0..<4 {
+                downloadStore.markQueuedDownloadFailed(
+                    withId: downloadIds[i],
+                    minRetryTimestamp: UInt64(400 - i * 100),
+                    tx: tx,
+                )
+            }
+            // Changes aren't answered from memory until they commit.
+            XCTAssertNil(queueIndex.peek(count: 10))
+        }
+        assertIndexMatchesDatabase()
+        XCTAssertEqual(queueIndex.summary(), .init(readyCount: 6, retryingCount: 4, nextRetryTimestamp: 100))
+
+        // Deleting an attachment deletes its download.
+        db.write { tx in
+            try! tx.database.execute(
+                sql: "DELETE FROM \(Attachment.Record.databaseTableName) WHERE id = ?",
+                arguments: [attachmentIds[9]],
+            )
+        }
+        assertIndexMatchesDatabase()
+
+        self.now = Date(millisecondsSince1970: 250)
+        db.write { tx in
+            downloadStore.updateRetryableDownloads(tx: tx)
+        }
+        assertIndexMatchesDatabase()
+        XCTAssertEqual(queueIndex.summary(), .init(readyCount: 7, retryingCount: 2, nextRetryTimestamp: 300))
+
+        db.write { tx in
+            downloadStore.removeAttachmentFromQueue(
+                withId: attachmentIds[5],
+                source: .transitTier,
+                tx: tx,
+            )
+        }
+        assertIndexMatchesDatabase()
+        XCTAssertEqual(queueIndex.summary(), .init(readyCount: 6, retryingCount: 2, nextRetryTimestamp: 300))
+    }
+
     // MARK: - Helpers
 
     private func insertAttachment() -> Attachment.IDType {
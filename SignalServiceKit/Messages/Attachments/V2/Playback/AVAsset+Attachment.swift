@@ -55,11 +55,13 @@ extension AVAsset {
         plaintextLength: UInt32,
         mimeType: String,
     ) throws -> AVAsset {
-        let fileHandle = try Cryptography.encryptedAttachmentFileHandle(
+        // AVFoundation re-reads headers and jumps around while scrubbing;
+        // cache decrypted pages so it doesn't re-decrypt the same bytes.
+        let fileHandle = CachingEncryptedFileHandle(wrapping: try Cryptography.encryptedAttachmentFileHandle(
             at: fileURL,
             plaintextLength: UInt64(safeCast: plaintextLength),
             attachmentKey: attachmentKey,
-        )
+        ))
 
         guard let utiType = MimeTypeUtil.utiTypeForMimeType(mimeType) else {
             throw OWSAssertionError("Invalid mime type")
@@ -8,22 +8,29 @@ import Foundation
 public class FailedMessagesJob {
     public init() {}
 
-    public func run(databaseStorage: SDSDatabaseStorage) async {
+    public func run(maintenanceScheduler: MaintenanceScheduler) async {
         var count = 0
-        await databaseStorage.awaitableWrite { writeTx in
-            InteractionFinder.attemptingOutInteractionIds(transaction: writeTx).forEach { failedInteractionId in
-                // Since we can't directly mutate the enumerated "attempting out" expired messages, we store
-                // only their ids in hopes of saving a little memory and then enumerate the (larger)
-                // TSMessage objects one at a time.
-                autoreleasepool {
-                    self.updateFailedMessageIfNecessary(failedInteractionId, count: &count, transaction: writeTx)
-                }
+        // Since we can't directly mutate the enumerated "attempting out" expired messages, we store
+        // only their ids in hopes of saving a little memory and then fetch the (larger) TSMessage
+        // objects one at a time. Each message is updated independently, so the updates are spread
+        // across several short transactions rather than holding the write lock for all of them.
+        var failedInteractionIds: [String]?
+        var nextIndex = 0
+        await maintenanceScheduler.runUntilDone(name: "FailedMessagesJob") { writeTx in
+            let ids = failedInteractionIds ?? InteractionFinder.attemptingOutInteractionIds(transaction: writeTx)
+            failedInteractionIds = ids
+
+            if nextIndex < ids.count {
+                self.updateFailedMessageIfNecessary(ids[nextIndex], count: &count, transaction: writeTx)
+                nextIndex += 1
+                return .more
             }
 
             StoryFinder.enumerateSendingStories(transaction: writeTx) { storyMessage, _ in
                 storyMessage.updateWithAllSendingRecipientsMarkedAsFailed(transaction: writeTx)
                 count += 1
             }
+            return .done
         }
         if count > 0 {
             Logger.info("Finished job. Marked \(count) incomplete sends as failed")
@@ -14,16 +14,23 @@ public class IncompleteCallsJob {
         self.cutoffTimestamp = cutoffDate.ows_millisecondsSince1970
     }
 
-    public func run(databaseStorage: SDSDatabaseStorage) async {
+    public func run(maintenanceScheduler: MaintenanceScheduler) async {
         var count = 0
-        await databaseStorage.awaitableWrite { writeTx in
-            InteractionFinder.incompleteCallIds(transaction: writeTx).forEach { incompleteCallId in
-                // Since we can't directly mutate the enumerated "incomplete" calls, we store only their ids in hopes
-                // of saving a little memory and then enumerate the (larger) TSCall objects one at a time.
-                autoreleasepool {
-                    self.updateIncompleteCallIfNecessary(incompleteCallId, count: &count, transaction: writeTx)
-                }
+        // Since we can't directly mutate the enumerated "incomplete" calls, we store only their ids in hopes
+        // of saving a little memory and then fetch the (larger) TSCall objects one at a time, spreading the
+        // updates across several short transactions.
+        var incompleteCallIds: [String]?
+        var nextIndex = 0
+        await maintenanceScheduler.runUntilDone(name: "IncompleteCallsJob") { writeTx in
+            let ids = incompleteCallIds ?? InteractionFinder.incompleteCallIds(transaction: writeTx)
+            incompleteCallIds = ids
+
+            guard nextIndex < ids.count else {
+                return .done
             }
+            self.updateIncompleteCallIfNecessary(ids[nextIndex], count: &count, transaction: writeTx)
+            nextIndex += 1
+            return .more
         }
         if count > 0 {
             Logger.info("Finished job. Updated \(count) incomplete calls")
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: AGPL-3.0-only
 //
 
+import GRDB
+
 public enum InteractionDelete {
     /// Specifies the desired side effects of deleting interactions.
     public struct SideEffects {
@@ -110,6 +112,26 @@ public protocol InteractionDeleteManager {
         sideEffects: SideEffects,
         tx: DBWriteTransaction,
     )
+
+    /// Removes up to `limit` of the newest interactions in the given thread
+    /// with row IDs at or before `rowId`.
+    ///
+    /// Most interactions are deleted, along with the rows referring to them,
+    /// a batch at a time in SQL, without being fetched. Only those whose
+    /// deletion has further side effects (calls, edited messages and story
+    /// replies) are fetched and deleted one at a time.
+    ///
+    /// The thread isn't updated, and no sync messages are sent.
+    ///
+    /// - Returns
+    /// The number of interactions deleted. 0 means none were left.
+    func deleteInteractions(
+        threadUniqueId: String,
+        atOrBeforeRowId rowId: Int64,
+        limit: Int,
+        associatedCallDelete: SideEffects.AssociatedCallDeleteBehavior,
+        tx: DBWriteTransaction,
+    ) -> Int
 }
 
 public extension InteractionDeleteManager {
@@ -208,6 +230,113 @@ final class InteractionDeleteManagerImpl: InteractionDeleteManager {
         )
     }
 
+    func deleteInteractions(
+        threadUniqueId: String,
+        atOrBeforeRowId rowId: Int64,
+        limit: Int,
+        associatedCallDelete: SideEffects.AssociatedCallDeleteBehavior,
+        tx: DBWriteTransaction,
+    ) -> Int {
+        let candidates = failIfThrows {
+            try Row.fetchAll(
+                tx.database,
+                sql: """
+                SELECT
+                    \(interactionColumn: .id),
+                    \(interactionColumn: .uniqueId),
+                    \(interactionColumn: .recordType),
+                    \(interactionColumn: .editState),
+                    \(interactionColumn: .storyTimestamp)
+                FROM \(InteractionRecord.databaseTableName)
+                \(DEBUG_INDEXED_BY("index_interactions_on_threadUniqueId_and_id"))
+                WHERE \(interactionColumn: .threadUniqueId) = ?
+                AND \(interactionColumn: .id) <= ?
+                ORDER BY \(interactionColumn: .id) DESC
+                LIMIT ?
+                """,
+                arguments: [threadUniqueId, rowId, limit],
+            )
+        }
+
+        var bulkUniqueIdsByRowId = [Int64: String]()
+        var individualRowIds = [Int64]()
+        for candidate in candidates {
+            let candidateRowId: Int64 = candidate[0]
+            let recordType: Int? = candidate[2]
+            let editState: Int? = candidate[3]
+            let storyTimestamp: Int64? = candidate[4]
+
+            let isCall = recordType == Int(SDSRecordType.call.rawValue)
+                || recordType == Int(SDSRecordType.groupCallMessage.rawValue)
+            let hasEdits = (editState ?? TSEditState.none.rawValue) != TSEditState.none.rawValue
+            let isStoryReply = storyTimestamp != nil
+
+            if isCall || hasEdits || isStoryReply {
+                individualRowIds.append(candidateRowId)
+            } else {
+                let uniqueId: String = candidate[1]
+                bulkUniqueIdsByRowId[candidateRowId] = uniqueId
+            }
+        }
+
+        // Edits delete their other revisions, which may be among these, so
+        // fetch each one just before deleting it.
+        for individualRowId in individualRowIds {
+            guard let interaction = interactionStore.fetchInteraction(rowId: individualRowId, tx: tx) else {
+                continue
+            }
+            _deleteInternal(
+                interaction: interaction,
+                knownAssociatedCallRecord: nil,
+                sideEffects: .custom(
+                    associatedCallDelete: associatedCallDelete,
+                    updateThreadOnInteractionDelete: .doNotUpdate,
+                ),
+                tx: tx,
+            )
+        }
+
+        if !bulkUniqueIdsByRowId.isEmpty {
+            deleteInBulk(uniqueIdsByRowId: bulkUniqueIdsByRowId, tx: tx)
+        }
+
+        return candidates.count
+    }
+
+    /// Does what ``_deleteInternal(interaction:knownAssociatedCallRecord:sideEffects:tx:)``
+    /// does for each of the given interactions, with one statement per table.
+    /// Only valid for interactions that aren't calls, edited messages or story
+    /// replies.
+    private func deleteInBulk(
+        uniqueIdsByRowId: [Int64: String],
+        tx: DBWriteTransaction,
+    ) {
+        let rowIds = Array(uniqueIdsByRowId.keys)
+        let uniqueIds = Array(uniqueIdsByRowId.values)
+
+        databaseStorage.updateIdMapping(interactionUniqueIdsByRowId: uniqueIdsByRowId, transaction: tx)
+
+        // Attachment references are deleted along with their owners by the
+        // foreign key cascade, as they are when deleting one at a time.
+        failIfThrows {
+            try tx.database.execute(
+                sql: """
+                DELETE FROM \(InteractionRecord.databaseTableName)
+                WHERE \(interactionColumn: .id) IN (\(databaseQuestionMarks(count: rowIds.count)))
+                """,
+                arguments: StatementArguments(rowIds),
+            )
+        }
+
+        messageSendLog.deleteAllPayloadsForInteractions(uniqueIds: uniqueIds, tx: tx)
+        for uniqueId in uniqueIds {
+            interactionReadCache.didRemove(interactionUniqueId: uniqueId, transaction: tx)
+        }
+        FullTextSearchIndexer.delete(messageUniqueIds: uniqueIds, tx: tx)
+        ReactionFinder.deleteAllReactions(uniqueMessageIds: uniqueIds, tx: tx)
+        MentionFinder.deleteAllMentions(uniqueMessageIds: uniqueIds, tx: tx)
+    }
+
     private func sendDeleteForMeSyncMessageIfNecessary(
         interactions: [TSInteraction],
         sideEffects: SideEffects,
@@ -317,12 +446,20 @@ final class InteractionDeleteManagerImpl: InteractionDeleteManager {
         interactionReadCache.didRemove(interaction: interaction, transaction: tx)
 
         if let message = interaction as? TSMessage {
+            let writeHookCapabilities = type(of: message).writeHookCapabilities
+
             FullTextSearchIndexer.delete(message, tx: tx)
 
-            message.removeAllAttachments(tx: tx)
+            if writeHookCapabilities.contains(.attachments) {
+                message.removeAllAttachments(tx: tx)
+            }
             message.removeAllReactions(transaction: tx)
-            message.removeAllMentions(transaction: tx)
-            message.touchStoryMessageIfNecessary(replyCountIncrement: .replyDeleted, transaction: tx)
+            if writeHookCapabilities.contains(.mentions) {
+                message.removeAllMentions(transaction: tx)
+            }
+            if writeHookCapabilities.contains(.storyReplies) {
+                message.touchStoryMessageIfNecessary(replyCountIncrement: .replyDeleted, transaction: tx)
+            }
         }
     }
 }
@@ -347,6 +484,21 @@ open class MockInteractionDeleteManager: InteractionDeleteManager {
     open func delete(alongsideAssociatedCallRecords callRecords: [CallRecord], sideEffects: SideEffects, tx: DBWriteTransaction) {
         deleteAlongsideCallRecordsMock!(callRecords, sideEffects)
     }
+
+    var deleteInteractionsInThreadMock: ((
+        _ threadUniqueId: String,
+        _ rowId: Int64,
+        _ limit: Int,
+    ) -> Int)?
+    open func deleteInteractions(
+        threadUniqueId: String,
+        atOrBeforeRowId rowId: Int64,
+        limit: Int,
+        associatedCallDelete: SideEffects.AssociatedCallDeleteBehavior,
+        tx: DBWriteTransaction,
+    ) -> Int {
+        return deleteInteractionsInThreadMock!(threadUniqueId, rowId, limit)
+    }
 }
 
 #endif
@@ -93,6 +93,20 @@ public class MentionFinder {
         }
     }
 
+    /// Deletes the mentions in all the messages with the given unique IDs.
+    public class func deleteAllMentions(uniqueMessageIds: [String], tx: DBWriteTransaction) {
+        guard !uniqueMessageIds.isEmpty else {
+            return
+        }
+        let sql = """
+            DELETE FROM \(TSMention.databaseTableName)
+            WHERE \(TSMention.columnName(.uniqueMessageId)) IN (\(databaseQuestionMarks(count: uniqueMessageIds.count)))
+        """
+        failIfThrows {
+            try tx.database.execute(sql: sql, arguments: StatementArguments(uniqueMessageIds))
+        }
+    }
+
     public class func mentionedAcis(for message: TSMessage, tx: DBReadTransaction) -> [Aci] {
         let sql = """
             SELECT \(TSMention.columnName(.aciString))
@@ -218,6 +218,14 @@ NS_ASSUME_NONNULL_BEGIN
     return OWSLocalizedString(@"ERROR_MESSAGE_UNKNOWN_ERROR", @"");
 }
 
+#pragma mark - Write Hooks
+
++ (TSMessageWriteHookCapabilities)writeHookCapabilities
+{
+    // Error messages never have mentions, story context or attachments.
+    return TSMessageWriteHookCapabilitiesNone;
+}
+
 #pragma mark - OWSReadTracking
 
 - (uint64_t)expireStartedAt
@@ -4,7 +4,7 @@
 //
 
 import Foundation
-import LibSignalClient
+public import LibSignalClient
 
 public protocol GroupUpdateItemBuilder {
     /// Build a list of group updates using the given precomputed, persisted
@@ -38,11 +38,16 @@ public protocol GroupUpdateItemBuilder {
     /// You should use this method if there are not precomputed update items,
     /// but we do have both an "old/new group model" from before and after a
     /// group update.
+    ///
+    /// - Parameter changedMemberServiceIds
+    /// If known, the only members whose state may differ between the models;
+    /// membership updates are computed for them alone.
     func precomputedUpdateItemsByDiffingModels(
         oldGroupModel: TSGroupModel,
         newGroupModel: TSGroupModel,
         oldDisappearingMessageToken: DisappearingMessageToken?,
         newDisappearingMessageToken: DisappearingMessageToken?,
+        changedMemberServiceIds: Set<ServiceId>?,
         localIdentifiers: LocalIdentifiers,
         groupUpdateSource: GroupUpdateSource,
         tx: DBReadTransaction,
@@ -96,6 +101,7 @@ extension GroupUpdateItemBuilder {
             newGroupModel: newGroupModel,
             oldDisappearingMessageToken: oldDisappearingMessageToken,
             newDisappearingMessageToken: newDisappearingMessageToken,
+            changedMemberServiceIds: nil,
             localIdentifiers: localIdentifiers,
             groupUpdateSource: groupUpdateSource,
             tx: tx,
@@ -175,6 +181,7 @@ public struct GroupUpdateItemBuilderImpl: GroupUpdateItemBuilder {
         newGroupModel: TSGroupModel,
         oldDisappearingMessageToken: DisappearingMessageToken?,
         newDisappearingMessageToken: DisappearingMessageToken?,
+        changedMemberServiceIds: Set<ServiceId>?,
         localIdentifiers: LocalIdentifiers,
         groupUpdateSource: GroupUpdateSource,
         tx: DBReadTransaction,
@@ -187,6 +194,7 @@ public struct GroupUpdateItemBuilderImpl: GroupUpdateItemBuilder {
             newGroupModel: newGroupModel,
             oldDisappearingMessageToken: oldDisappearingMessageToken,
             newDisappearingMessageToken: newDisappearingMessageToken,
+            changedMemberServiceIds: changedMemberServiceIds,
             groupUpdateSource: groupUpdateSource,
             localIdentifiers: localIdentifiers,
         ).itemList
@@ -1138,6 +1146,8 @@ private struct DiffingGroupUpdateItemBuilder {
     private let localIdentifiers: LocalIdentifiers
     private let groupUpdateSource: GroupUpdateSource
     private let isReplacingJoinRequestPlaceholder: Bool
+    /// If known, the only members whose state may differ between the models.
+    private let changedMemberServiceIds: Set<ServiceId>?
 
     /// The update items, in order.
     private(set) var itemList = [PersistableGroupUpdateItem]()
@@ -1151,11 +1161,13 @@ private struct DiffingGroupUpdateItemBuilder {
         newGroupModel: TSGroupModel,
         oldDisappearingMessageToken: DisappearingMessageToken?,
         newDisappearingMessageToken: DisappearingMessageToken?,
+        changedMemberServiceIds: Set<ServiceId>?,
         groupUpdateSource: GroupUpdateSource,
         localIdentifiers: LocalIdentifiers,
     ) {
         self.localIdentifiers = localIdentifiers
         self.groupUpdateSource = groupUpdateSource
+        self.changedMemberServiceIds = changedMemberServiceIds
 
         if let oldGroupModelV2 = oldGroupModel as? TSGroupModelV2 {
             self.isReplacingJoinRequestPlaceholder = oldGroupModelV2.isJoinRequestPlaceholder
@@ -1477,6 +1489,16 @@ private struct DiffingGroupUpdateItemBuilder {
             {
                 membershipChanges.append(pniMembershipChange)
             }
+        } else if let changedMemberServiceIds {
+            // Nobody else's membership changed, so there's no need to compare
+            // everyone.
+            membershipChanges = changedMemberServiceIds.compactMap { serviceId in
+                return MembershipChange(
+                    address: SignalServiceAddress(serviceId),
+                    oldGroupMembership: oldGroupMembership,
+                    newGroupMembership: newGroupMembership,
+                )
+            }
         } else {
             let allMembers = oldGroupMembership.allMembersOfAnyKind.union(newGroupMembership.allMembersOfAnyKind)
 
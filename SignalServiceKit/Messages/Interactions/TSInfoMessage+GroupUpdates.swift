@@ -229,6 +229,7 @@ public extension TSInfoMessage {
                 newGroupModel: newGroupModel.groupModel,
                 oldDisappearingMessageToken: oldGroupModel.dmToken,
                 newDisappearingMessageToken: newGroupModel.dmToken,
+                changedMemberServiceIds: nil,
                 localIdentifiers: localIdentifiers,
                 groupUpdateSource: source,
                 tx: tx,
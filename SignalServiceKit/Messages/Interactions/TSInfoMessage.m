@@ -262,6 +262,14 @@ const InfoMessageUserInfoKey InfoMessageUserInfoKeyPinnedMessage = @"InfoMessage
     return [self _infoMessagePreviewTextWithTx:transaction];
 }
 
+#pragma mark - Write Hooks
+
++ (TSMessageWriteHookCapabilities)writeHookCapabilities
+{
+    // Info messages never have mentions, story context or attachments.
+    return TSMessageWriteHookCapabilitiesNone;
+}
+
 #pragma mark - OWSReadTracking
 
 - (void)markAsReadAtTimestamp:(uint64_t)readTimestamp
@@ -5094,18 +5094,28 @@ public extension TSInteraction {
             return
         }
 
-        guard let dbCopy = type(of: self).anyFetch(uniqueId: uniqueId, transaction: transaction) else {
+        // Load the record along with the model so that we only write back
+        // the columns that the block (or the update hooks) actually changed.
+        let dbRecord: InteractionRecord
+        let dbCopy: TSInteraction
+        do {
+            let sql = "SELECT * FROM \(InteractionRecord.databaseTableName) WHERE \(interactionColumn: .uniqueId) = ?"
+            let sqlRequest = SQLRequest<Void>(sql: sql, arguments: [uniqueId], cached: true)
+            guard let record = try InteractionRecord.fetchOne(transaction.database, sqlRequest) else {
+                return
+            }
+            dbRecord = record
+            dbCopy = try TSInteraction.fromRecord(record)
+        } catch {
+            owsFailDebug("error: \(error)")
             return
         }
 
-        // Don't apply the block twice to the same instance.
-        // It's at least unnecessary and actually wrong for some blocks.
-        // e.g. `block: { $0 in $0.someField++ }`
-        if dbCopy !== self {
-            block(dbCopy)
-        }
+        // dbCopy is always a fresh instance, so this never applies the block
+        // twice to the same instance.
+        block(dbCopy)
 
-        dbCopy.sdsSave(saveMode: .update, transaction: transaction)
+        dbCopy.sdsUpdateChangedColumns(from: dbRecord, transaction: transaction)
     }
 
     // This method is an alternative to `anyUpdate(transaction:block:)` methods.
@@ -81,8 +81,31 @@ typedef NS_CLOSED_ENUM(NSInteger, TSEditState) {
     TSEditState_LatestRevisionUnread
 };
 
+/// Write hook work that may apply to instances of a `TSMessage` class.
+///
+/// Hooks skip work outside of a class's `writeHookCapabilities`, so classes
+/// that can never have e.g. mentions or story context insert at close to raw
+/// row speed.
+typedef NS_OPTIONS(NSUInteger, TSMessageWriteHookCapabilities) {
+    TSMessageWriteHookCapabilitiesNone = 0,
+    /// Messages may have body ranges with mentions, which are mirrored into
+    /// `TSMention` rows.
+    TSMessageWriteHookCapabilitiesMentions = 1 << 0,
+    /// Messages may be story replies, which touch their `StoryMessage`.
+    TSMessageWriteHookCapabilitiesStoryReplies = 1 << 1,
+    /// Messages may own attachments, including oversize text.
+    TSMessageWriteHookCapabilitiesAttachments = 1 << 2,
+    TSMessageWriteHookCapabilitiesAll = TSMessageWriteHookCapabilitiesMentions
+        | TSMessageWriteHookCapabilitiesStoryReplies | TSMessageWriteHookCapabilitiesAttachments,
+};
+
 @interface TSMessage : TSInteraction <NSObject>
 
+/// The write hook work that may apply to instances of this class. This is a
+/// fixed property of the class; subclasses override it to opt out of work
+/// that can never apply to them.
+@property (class, nonatomic, readonly) TSMessageWriteHookCapabilities writeHookCapabilities;
+
 /// DO NOT USE.
 @property (nonatomic, nullable) NSArray<NSString *> *deprecated_attachmentIds;
 
@@ -522,11 +522,18 @@ static const NSUInteger OWSMessageSchemaVersion = 4;
 }
 
 
++ (TSMessageWriteHookCapabilities)writeHookCapabilities
+{
+    return TSMessageWriteHookCapabilitiesAll;
+}
+
 - (void)anyWillInsertWithTransaction:(DBWriteTransaction *)transaction
 {
     [super anyWillInsertWithTransaction:transaction];
 
-    [self insertMentionsInDatabaseWithTx:transaction];
+    if ([self.class writeHookCapabilities] & TSMessageWriteHookCapabilitiesMentions) {
+        [self insertMentionsInDatabaseWithTx:transaction];
+    }
 }
 
 - (void)anyDidInsertWithTransaction:(DBWriteTransaction *)transaction
@@ -537,7 +544,10 @@ static const NSUInteger OWSMessageSchemaVersion = 4;
 
     [self ensurePerConversationExpirationWithTransaction:transaction];
 
-    [self touchStoryMessageIfNecessaryWithReplyCountIncrement:ReplyCountIncrementNewReplyAdded transaction:transaction];
+    if ([self.class writeHookCapabilities] & TSMessageWriteHookCapabilitiesStoryReplies) {
+        [self touchStoryMessageIfNecessaryWithReplyCountIncrement:ReplyCountIncrementNewReplyAdded
+                                                      transaction:transaction];
+    }
 }
 
 - (void)anyWillUpdateWithTransaction:(DBWriteTransaction *)transaction
@@ -553,7 +563,10 @@ static const NSUInteger OWSMessageSchemaVersion = 4;
 
     [self ensurePerConversationExpirationWithTransaction:transaction];
 
-    [self touchStoryMessageIfNecessaryWithReplyCountIncrement:ReplyCountIncrementNoIncrement transaction:transaction];
+    if ([self.class writeHookCapabilities] & TSMessageWriteHookCapabilitiesStoryReplies) {
+        [self touchStoryMessageIfNecessaryWithReplyCountIncrement:ReplyCountIncrementNoIncrement
+                                                      transaction:transaction];
+    }
 }
 
 - (void)ensurePerConversationExpirationWithTransaction:(DBWriteTransaction *)transaction
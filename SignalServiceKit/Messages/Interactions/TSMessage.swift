@@ -60,7 +60,10 @@ public extension TSMessage {
     /// If you want a constant string representing the body of this message, this is it.
     @objc(rawBodyWithTransaction:)
     func rawBody(transaction: DBReadTransaction) -> String? {
-        if let oversizeText = try? self.oversizeTextAttachment(transaction: transaction)?.asStream()?.decryptedLongText() {
+        if
+            type(of: self).writeHookCapabilities.contains(.attachments),
+            let oversizeText = try? self.oversizeTextAttachment(transaction: transaction)?.asStream()?.decryptedLongText()
+        {
             return oversizeText
         }
         return self.body?.nilIfEmpty
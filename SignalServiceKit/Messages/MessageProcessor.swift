@@ -134,6 +134,8 @@ public class MessageProcessor {
         enqueueReceivedEnvelope(
             ReceivedEnvelope(
                 envelope: protoEnvelope,
+                serverGuid: ValidatedIncomingEnvelope.parseServerGuid(fromEnvelope: protoEnvelope),
+                byteCount: envelopeData.count,
                 serverDeliveryTimestamp: serverDeliveryTimestamp,
                 completion: completion,
             ),
@@ -181,6 +183,10 @@ public class MessageProcessor {
             while autoreleasepool(invoking: { self.drainNextBatch() }) {}
             self.isDrainingPendingEnvelopes.set(false)
             if self.pendingEnvelopes.isEmpty {
+                let metrics = self.pendingEnvelopes.takeMetrics()
+                if metrics.peakCount > 1 {
+                    Logger.info("Drained queue; peaked at \(metrics.peakCount) envelopes (\(metrics.peakByteCount) bytes), resized \(metrics.resizeCount) times")
+                }
                 NotificationCenter.default.postOnMainThread(name: Self.messageProcessorDidDrainQueue, object: nil)
             }
         }
@@ -272,7 +278,7 @@ public class MessageProcessor {
             processedEnvelopesCount += batchEnvelopes.count - remainingEnvelopes.count
         }
         for processedEnvelope in batchEnvelopes.prefix(processedEnvelopesCount) {
-            guard let serverGuid = ValidatedIncomingEnvelope.parseServerGuid(fromEnvelope: processedEnvelope.envelope) else {
+            guard let serverGuid = processedEnvelope.serverGuid else {
                 continue
             }
             recentlyProcessedGuids.pushBack(serverGuid)
@@ -579,7 +585,7 @@ private extension MessageProcessor {
         tx: DBWriteTransaction,
     ) -> ProcessingRequest {
         assertOnQueue(queueForProcessing)
-        if let serverGuid = ValidatedIncomingEnvelope.parseServerGuid(fromEnvelope: envelope.envelope), recentlyProcessedGuids.contains(serverGuid) {
+        if let serverGuid = envelope.serverGuid, recentlyProcessedGuids.contains(serverGuid) {
             return ProcessingRequest(envelope, state: .completed(error: OWSGenericError("Skipping because it was recently processed.")))
         }
         let builder = ProcessingRequestBuilder(
@@ -606,6 +612,10 @@ extension MessageProcessor: MessageProcessingPipelineStage {
 
 private struct ReceivedEnvelope {
     let envelope: SSKProtoEnvelope
+    /// Parsed once when enqueued; it's checked before and after processing.
+    let serverGuid: UUID?
+    /// The size of the serialized envelope.
+    let byteCount: Int
     let serverDeliveryTimestamp: UInt64
     let completion: () -> Void
 
@@ -663,7 +673,19 @@ public enum EnvelopeSource {
 
 private class PendingEnvelopes {
     private let unfairLock = UnfairLock()
-    private var pendingEnvelopes = [ReceivedEnvelope]()
+    /// A ring buffer so that removing a processed batch doesn't shift the
+    /// (possibly thousands of) envelopes behind it during catch-up.
+    private var pendingEnvelopes = RingBuffer<ReceivedEnvelope>(minimumCapacity: 64)
+    private var pendingByteCount = 0
+    private var metrics = Metrics()
+
+    /// How large the queue got since the metrics were last taken.
+    struct Metrics {
+        var peakCount = 0
+        var peakByteCount = 0
+        /// How many times the queue's buffer grew or shrank.
+        var resizeCount = 0
+    }
 
     var isEmpty: Bool {
         unfairLock.withLock { pendingEnvelopes.isEmpty }
@@ -689,19 +711,42 @@ private class PendingEnvelopes {
 
     func removeProcessedEnvelopes(_ processedEnvelopesCount: Int) {
         unfairLock.withLock {
+            for processedEnvelope in pendingEnvelopes.prefix(processedEnvelopesCount) {
+                pendingByteCount -= processedEnvelope.byteCount
+            }
+            let oldCapacity = pendingEnvelopes.capacity
             pendingEnvelopes.removeFirst(processedEnvelopesCount)
+            if pendingEnvelopes.capacity != oldCapacity {
+                metrics.resizeCount += 1
+            }
         }
     }
 
     func removeAll() {
         unfairLock.withLock {
             pendingEnvelopes.removeAll()
+            pendingByteCount = 0
         }
     }
 
     func enqueue(_ receivedEnvelope: ReceivedEnvelope) {
         unfairLock.withLock {
+            let oldCapacity = pendingEnvelopes.capacity
             pendingEnvelopes.append(receivedEnvelope)
+            if pendingEnvelopes.capacity != oldCapacity {
+                metrics.resizeCount += 1
+            }
+            pendingByteCount += receivedEnvelope.byteCount
+            metrics.peakCount = max(metrics.peakCount, pendingEnvelopes.count)
+            metrics.peakByteCount = max(metrics.peakByteCount, pendingByteCount)
+        }
+    }
+
+    /// Returns the metrics gathered so far and starts gathering anew.
+    func takeMetrics() -> Metrics {
+        unfairLock.withLock {
+            defer { metrics = Metrics() }
+            return metrics
         }
     }
 }
@@ -362,28 +362,45 @@ public class MessageSendLog {
         }
     }
 
-    public func cleanUpExpiredEntries() async throws {
-        let cutoffTimestamp = currentExpiredPayloadTimestamp()
-        let fetchRequest = Payload
-            .select(Column("payloadId"), as: Int64.self)
-            .filter(Column("sentTimestamp") < cutoffTimestamp)
-            .limit(Constants.cleanupLimit)
-        var count = 0
-        try await TimeGatedBatch.processAll(db: db) { tx in
-            try Task.checkCancellation()
-            do {
-                let db = tx.database
-                let payloadIds = try fetchRequest.fetchAll(db)
-                try Payload.filter(keys: payloadIds).deleteAll(db)
-                count += payloadIds.count
-                return payloadIds.isEmpty ? .done(()) : .more
-            } catch {
-                throw error.grdbErrorForLogging
-            }
+    /// Deletes the payloads for all the interactions with the given unique
+    /// IDs in a single statement.
+    func deleteAllPayloadsForInteractions(
+        uniqueIds: [String],
+        tx: DBWriteTransaction,
+    ) {
+        guard !uniqueIds.isEmpty else {
+            return
+        }
+        do {
+            try tx.database.execute(
+                sql: """
+                DELETE FROM \(Payload.databaseTableName)
+                WHERE payloadId IN (
+                    SELECT payloadId FROM \(Message.databaseTableName)
+                    WHERE uniqueId IN (\(databaseQuestionMarks(count: uniqueIds.count)))
+                )
+                """,
+                arguments: StatementArguments(uniqueIds),
+            )
+        } catch {
+            owsFailDebug("Failed to delete payloads for \(uniqueIds.count) interactions: \(error)")
         }
+    }
 
-        if count > 0 {
-            Logger.info("Deleted \(count) stale MSL entries")
+    /// A ``MaintenanceScheduler`` step that deletes some expired entries.
+    public func cleanUpSomeExpiredEntries(tx: DBWriteTransaction) throws -> MaintenanceScheduler.StepResult {
+        let cutoffTimestamp = currentExpiredPayloadTimestamp()
+        do {
+            let db = tx.database
+            let payloadIds = try Payload
+                .select(Column("payloadId"), as: Int64.self)
+                .filter(Column("sentTimestamp") < cutoffTimestamp)
+                .limit(Constants.cleanupLimit)
+                .fetchAll(db)
+            try Payload.filter(keys: payloadIds).deleteAll(db)
+            return payloadIds.isEmpty ? .done : .more
+        } catch {
+            throw error.grdbErrorForLogging
         }
     }
 }
@@ -70,17 +70,10 @@ extension MessageSenderImpl {
                 throw OWSAssertionError("Can't use GSEs if some individual endorsements are missing")
             }
             authBuilder = { readyRecipients in
-                var combined = endorsements.combined
-                for serviceId in Set(threadRecipients).subtracting(readyRecipients) {
-                    // We checked just above that every element of `threadRecipients` has an
-                    // individual endorsement, so we can safely force-unwrap here.
-                    combined = combined.byRemoving(endorsements.individual[serviceId]!)
-                }
-                return .groupSend(GroupSendFullTokenBuilder(
-                    secretParams: endorsements.secretParams,
-                    expiration: endorsements.expiration,
-                    endorsement: combined,
-                ).build())
+                // We checked just above that every element of `threadRecipients` has an
+                // individual endorsement, so they can all be excluded.
+                let excludedServiceIds = Set(threadRecipients).subtracting(readyRecipients)
+                return .groupSend(endorsements.combinedTokenBuilder(excluding: excludedServiceIds).build())
             }
         } else {
             throw OWSAssertionError("Can't use Sender Key for a group message unless we have endorsements")
@@ -17,7 +17,7 @@ protocol DeviceMessageBuilder {
         serviceId: ServiceId,
         isSelfSend: Bool,
         encryptionStyle: EncryptionStyle,
-        buildPlaintextContent: (DeviceId, DBWriteTransaction) throws -> Data,
+        buildPlaintextContent: @escaping (DeviceId, DBWriteTransaction) throws -> Data,
         isTransient: Bool,
         sealedSenderParameters: SealedSenderParameters?,
         localAci: Aci,
@@ -30,16 +30,19 @@ public class MessageSenderImpl: MessageSender, DeviceMessageBuilder {
     private var preKeyManager: PreKeyManager { DependenciesBridge.shared.preKeyManager }
 
     let accountChecker: AccountChecker
-    private let groupSendEndorsementStore: GroupSendEndorsementStore
+    private let fanoutEncryptionWriter: CoalescingDatabaseWriter
+    private let groupSendEndorsementCache: GroupSendEndorsementCache
     let senderKeySendingManager: SenderKeySendingManager
 
     init(
         accountChecker: AccountChecker,
-        groupSendEndorsementStore: GroupSendEndorsementStore,
+        db: any DB,
+        groupSendEndorsementCache: GroupSendEndorsementCache,
         senderKeySendingManager: SenderKeySendingManager,
     ) {
         self.accountChecker = accountChecker
-        self.groupSendEndorsementStore = groupSendEndorsementStore
+        self.fanoutEncryptionWriter = CoalescingDatabaseWriter(db: db)
+        self.groupSendEndorsementCache = groupSendEndorsementCache
         self.senderKeySendingManager = senderKeySendingManager
 
     }
@@ -1011,30 +1014,7 @@ public class MessageSenderImpl: MessageSender, DeviceMessageBuilder {
         guard let groupRowId = GroupStore().fetchRowId(forGroupId: groupId, tx: tx) else {
             return nil
         }
-        let combinedRecord = groupSendEndorsementStore.fetchCombinedEndorsement(groupRowId: groupRowId, tx: tx)
-        guard let combinedRecord else {
-            return nil
-        }
-        let combinedEndorsement = try GroupSendEndorsement(contents: combinedRecord.endorsement)
-
-        var individualEndorsements = [ServiceId: GroupSendEndorsement]()
-        for record in groupSendEndorsementStore.fetchIndividualEndorsements(groupRowId: groupRowId, tx: tx) {
-            let endorsement = try GroupSendEndorsement(contents: record.endorsement)
-            let recipient = DependenciesBridge.shared.recipientDatabaseTable.fetchRecipient(rowId: record.recipientId, tx: tx)
-            guard let recipient else {
-                throw OWSAssertionError("Missing Recipient that must exist.")
-            }
-            guard let serviceId = recipient.aci ?? recipient.pni else {
-                throw OWSAssertionError("Missing ServiceId that must exist.")
-            }
-            individualEndorsements[serviceId] = endorsement
-        }
-        return GroupSendEndorsements(
-            secretParams: secretParams,
-            expiration: combinedRecord.expiration,
-            combined: combinedEndorsement,
-            individual: individualEndorsements,
-        )
+        return try groupSendEndorsementCache.fetchEndorsements(groupRowId: groupRowId, secretParams: secretParams, tx: tx)
     }
 
     private func handleSendFailure(
@@ -1448,7 +1428,10 @@ public class MessageSenderImpl: MessageSender, DeviceMessageBuilder {
     /// Builds ``DeviceMessage``s for a recipient.
     ///
     /// This method is heavily optimized for the fast path where a session
-    /// already exists for all of the recipient's devices.
+    /// already exists for all of the recipient's devices. On that path, the
+    /// only write transaction is shared with other recipients' encryptions
+    /// (see ``CoalescingDatabaseWriter``), so fanning a message out to a
+    /// large group doesn't open and wait for a transaction per recipient.
     ///
     /// - Parameters:
     ///   - serviceId: The recipient's ServiceId. This may be an ACI, a PNI, or
@@ -1476,7 +1459,7 @@ public class MessageSenderImpl: MessageSender, DeviceMessageBuilder {
         serviceId: ServiceId,
         isSelfSend: Bool,
         encryptionStyle: EncryptionStyle,
-        buildPlaintextContent: (DeviceId, DBWriteTransaction) throws -> Data,
+        buildPlaintextContent: @escaping (DeviceId, DBWriteTransaction) throws -> Data,
         isTransient: Bool,
         sealedSenderParameters: SealedSenderParameters?,
         localAci: Aci,
@@ -1487,7 +1470,7 @@ public class MessageSenderImpl: MessageSender, DeviceMessageBuilder {
 
         var deviceMessages: [DeviceMessage]
         let missingSessionPlaintextContent: [DeviceId: Data]
-        (deviceMessages, missingSessionPlaintextContent) = try await databaseStorage.awaitableWrite { tx -> ([DeviceMessage], [DeviceId: Data]) in
+        (deviceMessages, missingSessionPlaintextContent) = try await fanoutEncryptionWriter.write { tx -> ([DeviceMessage], [DeviceId: Data]) in
             let recipient = recipientDatabaseTable.fetchRecipient(serviceId: serviceId, transaction: tx)
 
             guard let recipient, recipient.isRegistered else {
@@ -12,6 +12,7 @@ public final class OWSDecryptionPlaceholderExpirationJob: ExpirationJob<OWSRecov
         dateProvider: @escaping DateProvider,
         db: DB,
         interactionDeleteManager: InteractionDeleteManager,
+        maintenanceScheduler: MaintenanceScheduler,
         messageTimestampGenerator: MessageTimestampGenerator,
         notificationPresenter: NotificationPresenter,
     ) {
@@ -23,6 +24,7 @@ public final class OWSDecryptionPlaceholderExpirationJob: ExpirationJob<OWSRecov
             dateProvider: dateProvider,
             db: db,
             logger: PrefixedLogger(prefix: "[DecryptionPlaceholderExpJob]"),
+            maintenanceScheduler: maintenanceScheduler,
         )
     }
 
@@ -359,6 +359,15 @@ public class PreparedOutgoingMessage {
             return message is OutgoingPinMessage || message is OutgoingUnpinMessage
         }
     }
+
+    public var isSyncMessage: Bool {
+        switch messageType {
+        case .persisted, .editMessage, .story:
+            return false
+        case .transient(let message):
+            return message is OutgoingSyncMessage
+        }
+    }
 }
 
 extension Array where Element == PreparedOutgoingMessage {
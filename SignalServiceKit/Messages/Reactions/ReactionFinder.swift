@@ -136,4 +136,21 @@ public class ReactionFinder {
             )
         }
     }
+
+    /// Deletes the reactions to all the messages with the given unique IDs.
+    public static func deleteAllReactions(uniqueMessageIds: [String], tx: DBWriteTransaction) {
+        guard !uniqueMessageIds.isEmpty else {
+            return
+        }
+        let sql = """
+            DELETE FROM \(OWSReaction.databaseTableName)
+            WHERE \(OWSReaction.columnName(.uniqueMessageId)) IN (\(databaseQuestionMarks(count: uniqueMessageIds.count)))
+        """
+        failIfThrows {
+            try tx.database.execute(
+                sql: sql,
+                arguments: StatementArguments(uniqueMessageIds),
+            )
+        }
+    }
 }
@@ -201,18 +201,44 @@ extension FullTextSearchIndexer {
         )
     }
 
+    /// Deletes the indexed content of the messages with the given unique IDs.
+    public static func delete(
+        messageUniqueIds: [String],
+        tx: DBWriteTransaction,
+    ) {
+        guard !messageUniqueIds.isEmpty else {
+            return
+        }
+        executeUpdate(
+            sql: """
+            DELETE FROM \(contentTableName)
+            WHERE \(uniqueIdColumn) IN (\(databaseQuestionMarks(count: messageUniqueIds.count)))
+            AND \(collectionColumn) == ?
+            """,
+            arguments: StatementArguments(messageUniqueIds + [legacyCollectionName]),
+            // The SQL varies with the number of IDs; don't fill the cache.
+            useCachedStatement: false,
+            tx: tx,
+        )
+    }
+
     private static func executeUpdate(
         sql: String,
         arguments: StatementArguments,
+        useCachedStatement: Bool = true,
         tx: DBWriteTransaction,
     ) {
         do {
-            // Worth using a cached statement here, as we may be indexing many
-            // things at once.
-            try tx.database.executeWithCachedStatementThrows(
-                sql: sql,
-                arguments: arguments,
-            )
+            if useCachedStatement {
+                // Worth using a cached statement here, as we may be indexing
+                // many things at once.
+                try tx.database.executeWithCachedStatementThrows(
+                    sql: sql,
+                    arguments: arguments,
+                )
+            } else {
+                try tx.database.execute(sql: sql, arguments: arguments)
+            }
         } catch {
             // We intentionally don't use failIfThrows here because we know the
             // FTS index relatively frequently reports corruption errors; for
@@ -0,0 +1,88 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Runs small writes from concurrent tasks together, sharing write
+/// transactions between them.
+///
+/// A write submitted while no transaction is open starts one right away.
+/// Writes submitted while a transaction is open wait for it to finish and
+/// then share the next one, up to `maxBatchSize` at a time. Under load, this
+/// trades many short transactions (each paying for a hop to the write queue,
+/// a commit, and change observation) for a few longer ones.
+///
+/// Each write's result (or error) is returned once its transaction commits.
+/// A write that throws doesn't affect the others in its transaction, but
+/// anything it wrote before throwing is committed, as with
+/// ``DB/awaitableWrite(file:function:line:block:)``.
+///
+/// - Important
+/// Writes that share a transaction must not depend on each other. Use this
+/// only for writes that would be just as correct in one transaction as in
+/// separate ones.
+final class CoalescingDatabaseWriter {
+
+    /// Runs a write and returns a block that delivers its result.
+    private typealias PendingWrite = (DBWriteTransaction) -> () -> Void
+
+    private struct State {
+        var pendingWrites = [PendingWrite]()
+        var isWriting = false
+    }
+
+    private let db: any DB
+    private let maxBatchSize: Int
+    private let state = TSMutex(initialState: State())
+
+    init(db: any DB, maxBatchSize: Int = 32) {
+        owsPrecondition(maxBatchSize > 0)
+        self.db = db
+        self.maxBatchSize = maxBatchSize
+    }
+
+    func write<T, E>(_ block: @escaping (DBWriteTransaction) throws(E) -> T) async throws(E) -> T {
+        let result = await withCheckedContinuation { (continuation: CheckedContinuation<Result<T, E>, Never>) in
+            let pendingWrite: PendingWrite = { tx in
+                let result: Result<T, E>
+                do {
+                    result = .success(try block(tx))
+                } catch {
+                    result = .failure(error)
+                }
+                return { continuation.resume(returning: result) }
+            }
+            let shouldStartWriting = state.withLock { state in
+                state.pendingWrites.append(pendingWrite)
+                defer { state.isWriting = true }
+                return !state.isWriting
+            }
+            if shouldStartWriting {
+                Task { await self.writePendingWrites() }
+            }
+        }
+        return try result.get()
+    }
+
+    private func writePendingWrites() async {
+        while true {
+            let batch = state.withLock { state in
+                let batch = Array(state.pendingWrites.prefix(maxBatchSize))
+                state.pendingWrites.removeFirst(batch.count)
+                if batch.isEmpty {
+                    state.isWriting = false
+                }
+                return batch
+            }
+            if batch.isEmpty {
+                return
+            }
+            let deliverResults = await db.awaitableWrite { tx in
+                return batch.map { $0(tx) }
+            }
+            deliverResults.forEach { $0() }
+        }
+    }
+}
@@ -0,0 +1,217 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Collects per-call-site latency metrics for ``SDSDatabaseStorage``
+/// transactions.
+///
+/// For every call site that opens a transaction we keep histograms of how
+/// long the caller waited before its block started running (for writes, this
+/// is the time spent waiting for the write lock), how long the block ran, how
+/// many rows it touched, and how much of the block was spent inside
+/// `TSYapDatabaseObject` write hooks.
+///
+/// The most expensive call sites are periodically logged in a compact
+/// summary. Use ``snapshot()`` to inspect the raw metrics.
+public final class DatabaseTransactionMetrics {
+
+    public enum TransactionKind: String {
+        case read
+        case write
+    }
+
+    public struct CallSite: Hashable, CustomStringConvertible {
+        public let kind: TransactionKind
+        public let file: String
+        public let function: String
+        public let line: Int
+
+        public var description: String {
+            let filename = (file as NSString).lastPathComponent
+            return "\(kind.rawValue) [\(filename):\(line) \(function)]"
+        }
+    }
+
+    /// A histogram of non-negative values with power-of-two buckets.
+    public struct Histogram {
+        /// Bucket 0 counts zeroes; bucket `i` counts values in
+        /// `[2^(i-1), 2^i)`. The last bucket also counts all larger values.
+        public private(set) var buckets = [UInt64](repeating: 0, count: Self.bucketCount)
+        public private(set) var count: UInt64 = 0
+        public private(set) var sum: UInt64 = 0
+        public private(set) var max: UInt64 = 0
+
+        private static let bucketCount = 40
+
+        public init() {}
+
+        public mutating func record(_ value: UInt64) {
+            buckets[Swift.min(UInt64.bitWidth - value.leadingZeroBitCount, Self.bucketCount - 1)] += 1
+            count += 1
+            sum = sum.addingReportingOverflow(value).overflow ? .max : sum + value
+            max = Swift.max(max, value)
+        }
+
+        public var mean: UInt64 {
+            return count > 0 ? sum / count : 0
+        }
+
+        /// An upper bound for the value at the given percentile, which must be
+        /// in `0...1`. Precise to within a factor of two.
+        public func percentile(_ percentile: Double) -> UInt64 {
+            guard count > 0 else {
+                return 0
+            }
+            let threshold = Swift.max(1, UInt64((Double(count) * percentile).rounded(.up)))
+            var seenCount: UInt64 = 0
+            for (index, bucketCount) in buckets.enumerated() {
+                seenCount += bucketCount
+                if seenCount >= threshold {
+                    let bucketUpperBound: UInt64 = index == 0 ? 0 : (1 << index) - 1
+                    return Swift.min(bucketUpperBound, max)
+                }
+            }
+            return max
+        }
+    }
+
+    public struct CallSiteMetrics {
+        public let callSite: CallSite
+        /// Microseconds between asking for the transaction and the block
+        /// starting to run.
+        public fileprivate(set) var waitMicros = Histogram()
+        /// Microseconds spent running the block.
+        public fileprivate(set) var blockMicros = Histogram()
+        /// Rows inserted, updated or deleted by the block, including rows
+        /// touched by triggers. Only recorded for writes.
+        public fileprivate(set) var rowsTouched = Histogram()
+        /// Microseconds of the block spent in `anyWill*`/`anyDid*` hooks. Only
+        /// recorded for writes.
+        public fileprivate(set) var writeHookMicros = Histogram()
+
+        fileprivate init(callSite: CallSite) {
+            self.callSite = callSite
+        }
+    }
+
+    struct Measurement {
+        let requestDate: MonotonicDate
+        let blockStartDate: MonotonicDate
+        let blockEndDate: MonotonicDate
+        var rowsTouched: Int?
+        var writeHookNanos: UInt64?
+    }
+
+    private struct State {
+        var metrics = [CallSite: CallSiteMetrics]()
+        var lastSummaryDate = MonotonicDate()
+    }
+
+    private let logger = PrefixedLogger(prefix: "[DBMetrics]")
+    private let _isEnabled: AtomicBool
+    private let state = TSMutex(initialState: State())
+    private let summaryInterval: MonotonicDuration
+    private let summaryCallSiteLimit: Int
+
+    public init(
+        isEnabled: Bool = DebugFlags.internalLogging,
+        summaryInterval: MonotonicDuration = MonotonicDuration(clampingSeconds: 5 * .minute),
+        summaryCallSiteLimit: Int = 8,
+    ) {
+        self._isEnabled = AtomicBool(isEnabled, lock: .init())
+        self.summaryInterval = summaryInterval
+        self.summaryCallSiteLimit = summaryCallSiteLimit
+    }
+
+    /// Whether transactions are currently being measured. Measurement has a
+    /// small per-transaction cost, so it's only on by default in internal
+    /// builds.
+    public var isEnabled: Bool {
+        get { _isEnabled.get() }
+        set { _isEnabled.set(newValue) }
+    }
+
+    // MARK: -
+
+    func record(_ measurement: Measurement, kind: TransactionKind, file: String, function: String, line: Int) {
+        let callSite = CallSite(kind: kind, file: file, function: function, line: line)
+        let shouldLogSummary = state.withLock { (state: inout State) -> Bool in
+            var metrics = state.metrics.removeValue(forKey: callSite) ?? CallSiteMetrics(callSite: callSite)
+            metrics.waitMicros.record((measurement.blockStartDate - measurement.requestDate).nanoseconds / NSEC_PER_USEC)
+            metrics.blockMicros.record((measurement.blockEndDate - measurement.blockStartDate).nanoseconds / NSEC_PER_USEC)
+            if let rowsTouched = measurement.rowsTouched {
+                metrics.rowsTouched.record(UInt64(Swift.max(0, rowsTouched)))
+            }
+            if let writeHookNanos = measurement.writeHookNanos {
+                metrics.writeHookMicros.record(writeHookNanos / NSEC_PER_USEC)
+            }
+            state.metrics[callSite] = metrics
+
+            guard
+                measurement.blockEndDate > state.lastSummaryDate,
+                measurement.blockEndDate - state.lastSummaryDate >= summaryInterval
+            else {
+                return false
+            }
+            state.lastSummaryDate = measurement.blockEndDate
+            return true
+        }
+        if shouldLogSummary {
+            logSummary()
+        }
+    }
+
+    /// The metrics collected so far, ordered by the total time each call
+    /// site spent waiting and running (most expensive first).
+    public func snapshot() -> [CallSiteMetrics] {
+        let metrics = state.withLock { Array($0.metrics.values) }
+        return metrics.sorted { Self.totalMicros($0) > Self.totalMicros($1) }
+    }
+
+    public func reset() {
+        state.withLock { $0.metrics.removeAll() }
+    }
+
+    /// Logs one line per call site for the most expensive call sites.
+    public func logSummary() {
+        let metrics = snapshot()
+        guard !metrics.isEmpty else {
+            return
+        }
+        logger.info("\(metrics.count) call sites; top \(min(metrics.count, summaryCallSiteLimit)):")
+        for callSiteMetrics in metrics.prefix(summaryCallSiteLimit) {
+            logger.info(Self.summaryLine(callSiteMetrics))
+        }
+    }
+
+    private static func totalMicros(_ metrics: CallSiteMetrics) -> UInt64 {
+        return metrics.waitMicros.sum + metrics.blockMicros.sum
+    }
+
+    static func summaryLine(_ metrics: CallSiteMetrics) -> String {
+        func format(_ histogram: Histogram) -> String {
+            return "\(formatMicros(histogram.percentile(0.5)))/\(formatMicros(histogram.percentile(0.99)))/\(formatMicros(histogram.max))"
+        }
+
+        var result = "\(metrics.callSite) n=\(metrics.blockMicros.count)"
+        result += " wait=\(format(metrics.waitMicros))"
+        result += " block=\(format(metrics.blockMicros))"
+        if metrics.rowsTouched.count > 0 {
+            result += " rows=\(metrics.rowsTouched.mean)/\(metrics.rowsTouched.max)"
+        }
+        if metrics.writeHookMicros.sum > 0 {
+            result += " hooks=\(formatMicros(metrics.writeHookMicros.sum))"
+        }
+        return result
+    }
+
+    private static func formatMicros(_ micros: UInt64) -> String {
+        if micros < 1000 {
+            return "\(micros)us"
+        }
+        return String(format: "%0.1fms", Double(micros) / 1000)
+    }
+}
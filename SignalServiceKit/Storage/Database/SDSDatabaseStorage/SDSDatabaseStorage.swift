@@ -30,6 +30,12 @@ public class SDSDatabaseStorage: NSObject, DB {
     public private(set) var grdbStorage: GRDBDatabaseStorageAdapter
     public var databaseChangeObserver: DatabaseChangeObserver { _databaseChangeObserver }
 
+    /// Per-call-site timing for transactions opened through this storage.
+    public let transactionMetrics = DatabaseTransactionMetrics()
+
+    /// Per-class timing for `TSYapDatabaseObject` write hooks. Off by default.
+    public let writeHookCostAccounting = WriteHookCostAccounting()
+
     public init(appReadiness: AppReadiness, databaseFileUrl: URL, keychainStorage: any KeychainStorage) throws {
         self.appReadiness = appReadiness
         self._databaseChangeObserver = DatabaseChangeObserverImpl(appReadiness: appReadiness)
@@ -139,6 +145,12 @@ public class SDSDatabaseStorage: NSObject, DB {
         }
     }
 
+    public func updateIdMapping(interactionUniqueIdsByRowId: [Int64: String], transaction tx: DBWriteTransaction) {
+        DatabaseChangeObserverImpl.serializedSync {
+            _databaseChangeObserver.updateIdMapping(interactionUniqueIdsByRowId: interactionUniqueIdsByRowId, transaction: tx)
+        }
+    }
+
     // MARK: - Touch
 
     public func touch(interaction: TSInteraction, shouldReindex: Bool, tx: DBWriteTransaction) {
@@ -235,7 +247,27 @@ public class SDSDatabaseStorage: NSObject, DB {
         line: Int,
         block: (DBReadTransaction) throws -> T,
     ) throws -> T {
-        try grdbStorage.read { try block($0) }
+        guard transactionMetrics.isEnabled else {
+            return try grdbStorage.read { try block($0) }
+        }
+
+        let requestDate = MonotonicDate()
+        return try grdbStorage.read { tx in
+            defer {
+                transactionMetrics.record(
+                    DatabaseTransactionMetrics.Measurement(
+                        requestDate: requestDate,
+                        blockStartDate: tx.startDate,
+                        blockEndDate: MonotonicDate(),
+                    ),
+                    kind: .read,
+                    file: file,
+                    function: function,
+                    line: line,
+                )
+            }
+            return try block(tx)
+        }
     }
 
     @objc(readWithBlock:)
@@ -293,10 +325,44 @@ public class SDSDatabaseStorage: NSObject, DB {
             }
         }
 
+        let requestDate: MonotonicDate? = transactionMetrics.isEnabled ? MonotonicDate() : nil
+        let isAccountingWriteHookCosts = writeHookCostAccounting.isEnabled
+
         try grdbStorage.writeWithTxCompletion { tx in
-            Bench(title: benchTitle, logIfLongerThan: timeoutThreshold, logInProduction: true) {
+            if isAccountingWriteHookCosts {
+                tx.writeHookCosts = WriteHookCosts()
+            }
+            defer {
+                if let writeHookCosts = tx.writeHookCosts {
+                    writeHookCostAccounting.merge(writeHookCosts)
+                }
+            }
+
+            guard let requestDate else {
+                return Bench(title: benchTitle, logIfLongerThan: timeoutThreshold, logInProduction: true) {
+                    block(tx)
+                }
+            }
+
+            tx.isMeasuringWriteHooks = true
+            let changesCountBefore = tx.database.totalChangesCount
+            let txCompletion = Bench(title: benchTitle, logIfLongerThan: timeoutThreshold, logInProduction: true) {
                 block(tx)
             }
+            transactionMetrics.record(
+                DatabaseTransactionMetrics.Measurement(
+                    requestDate: requestDate,
+                    blockStartDate: tx.startDate,
+                    blockEndDate: MonotonicDate(),
+                    rowsTouched: tx.database.totalChangesCount - changesCountBefore,
+                    writeHookNanos: tx.writeHookNanos,
+                ),
+                kind: .write,
+                file: file,
+                function: function,
+                line: line,
+            )
+            return txCompletion
         }
     }
 
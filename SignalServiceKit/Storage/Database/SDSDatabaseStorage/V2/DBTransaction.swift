@@ -32,6 +32,15 @@ public class DBWriteTransaction: DBReadTransaction, LibSignalClient.StoreContext
     private var finalizationBlocks: [String: FinalizationBlock]
     private(set) var completionBlocks: [CompletionBlock]
 
+    /// Whether time spent in `TSYapDatabaseObject` write hooks should be
+    /// accumulated into ``writeHookNanos``.
+    var isMeasuringWriteHooks = false
+    private(set) var writeHookNanos: UInt64 = 0
+    /// If non-nil, accumulates per-class write hook costs for this transaction.
+    var writeHookCosts: WriteHookCosts?
+    /// Time spent in hooks nested inside each currently-running measured hook.
+    private var nestedWriteHookNanos = [UInt64]()
+
     override init(database: Database) {
         self.transactionState = .open
         self.finalizationBlocks = [:]
@@ -80,6 +89,30 @@ public class DBWriteTransaction: DBReadTransaction, LibSignalClient.StoreContext
     public func addSyncCompletion(block: @escaping () -> Void) {
         completionBlocks.append(block)
     }
+
+    // MARK: -
+
+    /// Run the given write hook, accumulating its duration if we're measuring.
+    ///
+    /// Hooks may save other models, which run their own hooks. Only the
+    /// outermost hook counts towards ``writeHookNanos``, and per-class costs
+    /// exclude time spent in nested hooks, so no time is counted twice.
+    func measureWriteHook(_ hook: WriteHook, of model: TSYapDatabaseObject, block: () -> Void) {
+        guard isMeasuringWriteHooks || writeHookCosts != nil else {
+            return block()
+        }
+        let startDate = MonotonicDate()
+        nestedWriteHookNanos.append(0)
+        block()
+        let nestedNanos = nestedWriteHookNanos.removeLast()
+        let durationNanos = (MonotonicDate() - startDate).nanoseconds
+        if nestedWriteHookNanos.isEmpty {
+            writeHookNanos += durationNanos
+        } else {
+            nestedWriteHookNanos[nestedWriteHookNanos.count - 1] += durationNanos
+        }
+        writeHookCosts?.record(hook, modelClass: type(of: model), nanos: durationNanos - nestedNanos)
+    }
 }
 
 // MARK: -
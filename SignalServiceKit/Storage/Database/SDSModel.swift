@@ -29,9 +29,9 @@ public extension SDSModel {
 
         switch saveMode {
         case .insert:
-            anyWillInsert(with: tx)
+            tx.measureWriteHook(.willInsert, of: self) { anyWillInsert(with: tx) }
         case .update:
-            anyWillUpdate(with: tx)
+            tx.measureWriteHook(.willUpdate, of: self) { anyWillUpdate(with: tx) }
         }
 
         let record = asRecord()
@@ -39,19 +39,36 @@ public extension SDSModel {
 
         switch saveMode {
         case .insert:
-            anyDidInsert(with: tx)
+            tx.measureWriteHook(.didInsert, of: self) { anyDidInsert(with: tx) }
         case .update:
-            anyDidUpdate(with: tx)
+            tx.measureWriteHook(.didUpdate, of: self) { anyDidUpdate(with: tx) }
         }
     }
 
+    /// Like `sdsSave(saveMode: .update, transaction:)`, but only writes the
+    /// columns that differ from `dbRecord`, the record this model was loaded
+    /// from earlier in the same transaction.
+    func sdsUpdateChangedColumns(from dbRecord: SDSRecord, transaction tx: DBWriteTransaction) {
+        guard shouldBeSaved else {
+            Logger.warn("Skipping save of: \(type(of: self))")
+            return
+        }
+
+        tx.measureWriteHook(.willUpdate, of: self) { anyWillUpdate(with: tx) }
+
+        let record = asRecord()
+        record.sdsUpdateChangedColumns(from: dbRecord, transaction: tx)
+
+        tx.measureWriteHook(.didUpdate, of: self) { anyDidUpdate(with: tx) }
+    }
+
     func sdsRemove(transaction tx: DBWriteTransaction) {
         guard shouldBeSaved else {
             // Skipping remove.
             return
         }
 
-        anyWillRemove(with: tx)
+        tx.measureWriteHook(.willRemove, of: self) { anyWillRemove(with: tx) }
 
         // Don't use a record to delete the record;
         // asRecord() is expensive.
@@ -67,7 +84,7 @@ public extension SDSModel {
             )
         }
 
-        anyDidRemove(with: tx)
+        tx.measureWriteHook(.didRemove, of: self) { anyDidRemove(with: tx) }
     }
 }
 
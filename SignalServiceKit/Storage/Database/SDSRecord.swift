@@ -67,6 +67,35 @@ public extension SDSRecord {
             try self.insert(transaction.database)
         }
     }
+
+    /// Updates the row that `dbRecord` was loaded from, writing only the
+    /// columns whose values differ between `dbRecord` and this record.
+    ///
+    /// SQLite only maintains the indexes and fires the `UPDATE OF` triggers
+    /// that cover the columns in an `UPDATE`'s `SET` list, so this is much
+    /// cheaper than ``sdsSave(saveMode:transaction:)`` for the common case of
+    /// changing one or two properties of a wide row.
+    ///
+    /// - Parameter dbRecord: The record as it's currently stored, i.e. loaded
+    ///   earlier in the same write transaction.
+    func sdsUpdateChangedColumns(from dbRecord: SDSRecord, transaction: DBWriteTransaction) {
+        guard let grdbId = dbRecord.id else {
+            owsFailDebug("Missing id for stored record.")
+            sdsSave(saveMode: .update, transaction: transaction)
+            return
+        }
+
+        var changes = SDSRecordChanges(from: dbRecord, to: self)
+        if changes.isEmpty {
+            changes = .touch(self)
+        }
+
+        let sql = SDSUpdateStatementCache.shared.sql(for: self, columnNames: changes.columnNames)
+        transaction.database.executeWithCachedStatement(
+            sql: sql,
+            arguments: StatementArguments(changes.values + [grdbId.databaseValue]),
+        )
+    }
 }
 
 // MARK: -
@@ -0,0 +1,104 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import GRDB
+
+/// The columns whose values differ between two records of the same type.
+struct SDSRecordChanges {
+    /// The names of the changed columns, sorted.
+    let columnNames: [String]
+    /// The new values for `columnNames`, in the same order.
+    let values: [DatabaseValue]
+
+    init(from oldRecord: SDSRecord, to newRecord: SDSRecord) {
+        let oldValues = oldRecord.databaseDictionary
+        let changes = newRecord.databaseDictionary
+            .filter { columnName, newValue in
+                // The id identifies the row; it's never written by an update.
+                return columnName != "id" && oldValues[columnName] != newValue
+            }
+            .sorted { $0.key < $1.key }
+        self.columnNames = changes.map(\.key)
+        self.values = changes.map(\.value)
+    }
+
+    private init(columnNames: [String], values: [DatabaseValue]) {
+        self.columnNames = columnNames
+        self.values = values
+    }
+
+    /// Writes a record's unique id back to itself. Updates with nothing to
+    /// change still touch the row so that database observers see them, just
+    /// like an update that rewrites every column.
+    static func touch(_ record: SDSRecord) -> SDSRecordChanges {
+        return SDSRecordChanges(columnNames: ["uniqueId"], values: [record.uniqueId.databaseValue])
+    }
+
+    var isEmpty: Bool {
+        return columnNames.isEmpty
+    }
+
+    /// The number of bytes bound to the statement that writes these changes.
+    var byteCount: Int {
+        return values.reduce(0) { $0 + Self.byteCount(of: $1) }
+    }
+
+    static func byteCount(of value: DatabaseValue) -> Int {
+        switch value.storage {
+        case .null:
+            return 0
+        case .int64, .double:
+            return 8
+        case .string(let string):
+            return string.utf8.count
+        case .blob(let data):
+            return data.count
+        }
+    }
+}
+
+// MARK: -
+
+/// Builds the SQL for column-minimal `UPDATE`s, keyed by record type and the
+/// set of columns being written.
+///
+/// Each distinct SQL string is passed to `Database.cachedStatement(sql:)`, so
+/// it is compiled once per connection and the prepared statement is then
+/// reused by every later update of the same columns, within and across
+/// transactions.
+final class SDSUpdateStatementCache {
+    static let shared = SDSUpdateStatementCache()
+
+    private struct Key: Hashable {
+        let recordType: ObjectIdentifier
+        let columnNames: [String]
+    }
+
+    /// In practice there are only a few dozen distinct column sets, one or
+    /// two per "updateWith..." method. This bounds the cache if that changes.
+    private static let maxCount = 512
+
+    private let sqlByKey = TSMutex(initialState: [Key: String]())
+
+    func sql(for record: SDSRecord, columnNames: [String]) -> String {
+        let key = Key(recordType: ObjectIdentifier(type(of: record)), columnNames: columnNames)
+        if let sql = sqlByKey.withLock({ $0[key] }) {
+            return sql
+        }
+
+        let tableName = record.tableMetadata.tableName
+        let assignments = columnNames.map { "\($0.quotedDatabaseIdentifier) = ?" }.joined(separator: ", ")
+        let sql = "UPDATE \(tableName.quotedDatabaseIdentifier) SET \(assignments) WHERE id = ?"
+
+        sqlByKey.withLock { sqlByKey in
+            if sqlByKey.count >= Self.maxCount {
+                sqlByKey.removeAll()
+            }
+            sqlByKey[key] = sql
+        }
+        return sql
+    }
+}
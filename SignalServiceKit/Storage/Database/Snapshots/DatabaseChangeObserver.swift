@@ -65,6 +65,7 @@ public protocol SDSDatabaseChangeObserver: DatabaseChangeObserver {
 
     func updateIdMapping(thread: TSThread, transaction: DBWriteTransaction)
     func updateIdMapping(interaction: TSInteraction, transaction: DBWriteTransaction)
+    func updateIdMapping(interactionUniqueIdsByRowId: [Int64: String], transaction: DBWriteTransaction)
 
     func didTouch(interaction: TSInteraction, transaction: DBWriteTransaction)
     func didTouch(thread: TSThread, shouldUpdateChatListUi: Bool, transaction: DBWriteTransaction)
@@ -390,6 +391,17 @@ extension DatabaseChangeObserverImpl: TransactionObserver {
         didModifyPendingChanges()
     }
 
+    public func updateIdMapping(interactionUniqueIdsByRowId: [Int64: String], transaction: DBWriteTransaction) {
+        AssertHasDatabaseChangeObserverLock()
+
+        for (rowId, uniqueId) in interactionUniqueIdsByRowId {
+            pendingChanges.insert(interactionUniqueId: uniqueId, rowId: rowId)
+        }
+        pendingChanges.insert(tableName: TSInteraction.table.tableName)
+
+        didModifyPendingChanges()
+    }
+
     public func didTouch(interaction: TSInteraction, transaction: DBWriteTransaction) {
         AssertHasDatabaseChangeObserverLock()
 
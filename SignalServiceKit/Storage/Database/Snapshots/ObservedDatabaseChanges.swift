@@ -133,6 +133,14 @@ class ObservedDatabaseChanges {
         interactions.insert(uniqueId: interactionUniqueId, state: .default)
     }
 
+    func insert(interactionUniqueId: UniqueId, rowId: RowId) {
+#if TESTABLE_BUILD
+        checkConcurrency()
+#endif
+
+        interactions.insert(uniqueId: interactionUniqueId, rowId: rowId, state: .default)
+    }
+
     func formUnion(interactionUniqueIds: Set<UniqueId>) {
 #if TESTABLE_BUILD
         checkConcurrency()
@@ -342,14 +350,18 @@ private struct ObservedModelChanges {
     }
 
     mutating func insert(model: SDSIdentifiableModel, state: ObservedModelState) {
-        _uniqueIds.insert(model.uniqueId, state)
         guard let grdbId = model.grdbId else {
+            _uniqueIds.insert(model.uniqueId, state)
             owsFailDebug("Missing grdbId")
             return
         }
-        let rowId: RowId = grdbId.int64Value
+        insert(uniqueId: model.uniqueId, rowId: grdbId.int64Value, state: state)
+    }
+
+    mutating func insert(uniqueId: UniqueId, rowId: RowId, state: ObservedModelState) {
+        _uniqueIds.insert(uniqueId, state)
         _rowIds.insert(rowId)
-        rowIdToUniqueIdMap[rowId] = model.uniqueId
+        rowIdToUniqueIdMap[rowId] = uniqueId
     }
 
     mutating func insert(uniqueId: UniqueId, state: ObservedModelState) {
@@ -0,0 +1,138 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// The `TSYapDatabaseObject` write hooks dispatched by ``SDSModel``.
+public enum WriteHook: String, CaseIterable {
+    case willInsert
+    case didInsert
+    case willUpdate
+    case didUpdate
+    case willRemove
+    case didRemove
+}
+
+// MARK: -
+
+/// Write hook costs accumulated over a single write transaction.
+///
+/// Lives on the ``DBWriteTransaction`` so recording a hook doesn't need to
+/// take a lock; it's merged into ``WriteHookCostAccounting`` once the
+/// transaction's block returns.
+struct WriteHookCosts {
+    struct Key: Hashable {
+        let modelClass: ObjectIdentifier
+        let hook: WriteHook
+    }
+
+    struct Cost {
+        let className: String
+        var count: UInt64 = 0
+        var totalNanos: UInt64 = 0
+        var maxNanos: UInt64 = 0
+
+        mutating func add(count: UInt64, totalNanos: UInt64, maxNanos: UInt64) {
+            self.count += count
+            self.totalNanos += totalNanos
+            self.maxNanos = max(self.maxNanos, maxNanos)
+        }
+    }
+
+    private(set) var costs = [Key: Cost]()
+
+    mutating func record(_ hook: WriteHook, modelClass: AnyClass, nanos: UInt64) {
+        let key = Key(modelClass: ObjectIdentifier(modelClass), hook: hook)
+        costs[key, default: Cost(className: String(describing: modelClass))].add(count: 1, totalNanos: nanos, maxNanos: nanos)
+    }
+}
+
+// MARK: -
+
+/// Opt-in accounting of the time spent in `TSYapDatabaseObject` write hooks
+/// (`anyWillInsert`, `anyDidInsert`, etc.), broken down by concrete model
+/// class and hook.
+///
+/// Times are "self" times: if a hook saves another model, the nested model's
+/// hooks are charged to the nested model's class and not to the outer hook.
+///
+/// When disabled, each write transaction pays for one flag check and each
+/// hook for a `nil` check.
+public final class WriteHookCostAccounting {
+
+    public struct Entry {
+        public let className: String
+        public let hook: WriteHook
+        public let count: UInt64
+        public let totalNanos: UInt64
+        public let maxNanos: UInt64
+
+        public var meanNanos: UInt64 {
+            return count > 0 ? totalNanos / count : 0
+        }
+    }
+
+    private let logger = PrefixedLogger(prefix: "[WriteHookCosts]")
+    private let _isEnabled: AtomicBool
+    private let costs = TSMutex(initialState: [WriteHookCosts.Key: WriteHookCosts.Cost]())
+
+    public init(isEnabled: Bool = false) {
+        self._isEnabled = AtomicBool(isEnabled, lock: .init())
+    }
+
+    /// Whether write transactions started from now on account for their
+    /// hook costs.
+    public var isEnabled: Bool {
+        get { _isEnabled.get() }
+        set { _isEnabled.set(newValue) }
+    }
+
+    func merge(_ transactionCosts: WriteHookCosts) {
+        guard !transactionCosts.costs.isEmpty else {
+            return
+        }
+        costs.withLock { costs in
+            for (key, cost) in transactionCosts.costs {
+                costs[key, default: WriteHookCosts.Cost(className: cost.className)].add(
+                    count: cost.count,
+                    totalNanos: cost.totalNanos,
+                    maxNanos: cost.maxNanos,
+                )
+            }
+        }
+    }
+
+    /// The costs accounted so far, most expensive first.
+    public func snapshot() -> [Entry] {
+        let entries = costs.withLock { costs in
+            return costs.map { key, cost in
+                Entry(
+                    className: cost.className,
+                    hook: key.hook,
+                    count: cost.count,
+                    totalNanos: cost.totalNanos,
+                    maxNanos: cost.maxNanos,
+                )
+            }
+        }
+        return entries.sorted { $0.totalNanos > $1.totalNanos }
+    }
+
+    public func reset() {
+        costs.withLock { $0.removeAll() }
+    }
+
+    public func logSummary() {
+        let entries = snapshot()
+        let totalNanos = entries.reduce(0, { $0 + $1.totalNanos })
+        logger.info("\(totalNanos / NSEC_PER_MSEC)ms in write hooks:")
+        for entry in entries {
+            var logString = "\(entry.className).\(entry.hook.rawValue): \(entry.count)x in \(entry.totalNanos / NSEC_PER_USEC)us."
+            logString += " Avg:\(entry.meanNanos / NSEC_PER_USEC)us"
+            logString += " Max:\(entry.maxNanos / NSEC_PER_USEC)us"
+            logger.info(logString)
+        }
+    }
+}
@@ -160,14 +160,29 @@ open class TSGroupThread: TSThread {
         Logger.info("Inserted group thread: \(self.groupId.hexadecimalString)")
     }
 
+    /// - Parameter changedMemberServiceIds
+    /// If known, the only members whose state may differ between the current
+    /// and new models. If none of them joined or left the full members, the
+    /// group member records are left alone.
     func update(
         with newGroupModel: TSGroupModel,
+        changedMemberServiceIds: Set<ServiceId>? = nil,
         transaction tx: DBWriteTransaction,
     ) {
         let didAvatarChange = newGroupModel.avatarHash == groupModel.avatarHash
         let didNameChange = newGroupModel.groupNameOrDefault == groupModel.groupNameOrDefault
 
         let oldGroupMembers = groupModel.groupMembers
+        let didFullMembersChange: Bool
+        if let changedMemberServiceIds {
+            let oldGroupMembership = groupModel.groupMembership
+            let newGroupMembership = newGroupModel.groupMembership
+            didFullMembersChange = changedMemberServiceIds.contains {
+                oldGroupMembership.isFullMember($0) != newGroupMembership.isFullMember($0)
+            }
+        } else {
+            didFullMembersChange = true
+        }
 
         anyUpdate(transaction: tx) { groupThread in
             if let oldGroupModelV2 = groupThread.groupModel as? TSGroupModelV2 {
@@ -182,8 +197,10 @@ open class TSGroupThread: TSThread {
             groupThread.groupModel = newGroupModel.copy() as! TSGroupModel
         }
 
-        updateGroupMemberRecords(transaction: tx)
-        clearGroupSendEndorsementsIfNeeded(oldGroupMembers: oldGroupMembers, tx: tx)
+        if didFullMembersChange {
+            updateGroupMemberRecords(transaction: tx)
+            clearGroupSendEndorsementsIfNeeded(oldGroupMembers: oldGroupMembers, tx: tx)
+        }
 
         SSKEnvironment.shared.databaseStorageRef.touch(
             thread: self,
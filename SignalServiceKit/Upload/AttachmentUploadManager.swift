@@ -1117,21 +1117,24 @@ public class AttachmentUploadManagerImpl: AttachmentUploadManager {
     }
 
     func buildMetadata(forUploading attachmentStream: AttachmentStream) throws -> Upload.LocalUploadMetadata {
-        // First we need to decrypt, so we can re-encrypt for upload.
-        let tmpDecryptedFile = fileSystem.temporaryFileUrl()
         let decryptionMedatata = DecryptionMetadata(
             key: try AttachmentKey(combinedKey: attachmentStream.attachment.encryptionKey),
             integrityCheck: .plaintextHash(attachmentStream.plaintextHash),
             plaintextLength: UInt64(safeCast: attachmentStream.unencryptedByteCount),
         )
-        try attachmentEncrypter.decryptAttachment(at: attachmentStream.fileURL, metadata: decryptionMedatata, output: tmpDecryptedFile)
 
-        // Now re-encrypt with a fresh set of keys.
+        // Decrypt and re-encrypt with a fresh set of keys in one pass, so the
+        // plaintext never touches disk.
         // We use a tmp file on purpose; we already have the source file for the attachment
         // and don't need to keep around this copy encrypted with different keys; its useful
-        // for upload only and can cleaned up by the OS after.
+        // for upload only and can cleaned up by the OS after. (The upload needs
+        // a file rather than a stream so it can be resumed at an offset.)
         let tmpReencryptedFile = fileSystem.temporaryFileUrl()
-        let reencryptedMetadata = try attachmentEncrypter.encryptAttachment(at: tmpDecryptedFile, output: tmpReencryptedFile)
+        let reencryptedMetadata = try attachmentEncrypter.reencryptAttachment(
+            at: attachmentStream.fileURL,
+            metadata: decryptionMedatata,
+            output: tmpReencryptedFile,
+        )
 
         // we upload the re-encrypted file.
         return try .validateAndBuild(fileUrl: tmpReencryptedFile, metadata: reencryptedMetadata)
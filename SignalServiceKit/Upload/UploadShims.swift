@@ -24,7 +24,7 @@ extension Upload {
 public protocol _Upload_AttachmentEncrypterShim {
     func encryptAttachment(at unencryptedUrl: URL, output encryptedUrl: URL) throws -> EncryptionMetadata
 
-    func decryptAttachment(at encryptedUrl: URL, metadata: DecryptionMetadata, output: URL) throws
+    func reencryptAttachment(at encryptedUrl: URL, metadata: DecryptionMetadata, output encryptedOutputUrl: URL) throws -> EncryptionMetadata
 }
 
 public protocol _Upload_FileSystemShim {
@@ -50,8 +50,8 @@ public struct _Upload_AttachmentEncrypterWrapper: Upload.Shims.AttachmentEncrypt
         try Cryptography.encryptAttachment(at: unencryptedUrl, output: encryptedUrl)
     }
 
-    public func decryptAttachment(at encryptedUrl: URL, metadata: DecryptionMetadata, output: URL) throws {
-        try Cryptography.decryptAttachment(at: encryptedUrl, metadata: metadata, output: output)
+    public func reencryptAttachment(at encryptedUrl: URL, metadata: DecryptionMetadata, output encryptedOutputUrl: URL) throws -> EncryptionMetadata {
+        try Cryptography.reencryptAttachment(at: encryptedUrl, metadata: metadata, output: encryptedOutputUrl)
     }
 }
 
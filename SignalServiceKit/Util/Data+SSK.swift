@@ -88,6 +88,16 @@ extension Data {
             shift += 7
         }
     }
+
+    /// Append `value` as a varint, the format ``removeFirstVarint()`` reads.
+    public mutating func appendVarint(_ value: UInt64) {
+        var value = value
+        while value >= 0x80 {
+            append(UInt8(truncatingIfNeeded: value) | 0x80)
+            value >>= 7
+        }
+        append(UInt8(value))
+    }
 }
 
 public extension Data {
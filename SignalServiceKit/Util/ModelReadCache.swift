@@ -202,6 +202,11 @@ class ModelReadCache<KeyType: Hashable & Equatable, ValueType> {
         updateCacheForWrite(cacheKey: cacheKey, value: nil, transaction: transaction)
     }
 
+    func didRemove(key: KeyType, transaction: DBWriteTransaction) {
+        let cacheKey = adapter.cacheKey(forKey: key)
+        updateCacheForWrite(cacheKey: cacheKey, value: nil, transaction: transaction)
+    }
+
     func didInsertOrUpdate(value: ValueType, transaction: DBWriteTransaction) {
         let cacheKey = adapter.cacheKey(forValue: value)
         updateCacheForWrite(cacheKey: cacheKey, value: value, transaction: transaction)
@@ -435,6 +440,10 @@ public class InteractionReadCache: NSObject {
         cache.didRemove(value: interaction, transaction: transaction)
     }
 
+    public func didRemove(interactionUniqueId: String, transaction: DBWriteTransaction) {
+        cache.didRemove(key: interactionUniqueId, transaction: transaction)
+    }
+
     @objc(didUpdateInteraction:transaction:)
     public func didUpdate(interaction: TSInteraction, transaction: DBWriteTransaction) {
         guard interaction.sortId > 0 else {
@@ -0,0 +1,86 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// A first-in, first-out queue backed by a circular buffer.
+///
+/// Unlike an `Array` used as a queue, removing elements from the front
+/// doesn't move the remaining elements, and the same storage is reused as
+/// elements pass through. The buffer doubles when it's full and, so that a
+/// burst doesn't leave a large buffer behind, halves (down to
+/// `minimumCapacity`) when it's less than a quarter full.
+public struct RingBuffer<Element> {
+    private var storage: [Element?]
+    private var headIndex = 0
+    private let minimumCapacity: Int
+
+    /// - Complexity: O(1)
+    public private(set) var count = 0
+
+    public init(minimumCapacity: Int = 8) {
+        owsPrecondition(minimumCapacity > 0)
+        self.storage = Array(repeating: nil, count: minimumCapacity)
+        self.minimumCapacity = minimumCapacity
+    }
+
+    /// - Complexity: O(1)
+    public var isEmpty: Bool {
+        return count == 0
+    }
+
+    /// The number of elements that fit without resizing.
+    public var capacity: Int {
+        return storage.count
+    }
+
+    /// - Complexity: O(1) on average
+    public mutating func append(_ element: Element) {
+        if count == storage.count {
+            resize(capacity: 2 * storage.count)
+        }
+        storage[(headIndex + count) % storage.count] = element
+        count += 1
+    }
+
+    /// Returns (up to) the first `maxLength` elements.
+    ///
+    /// - Complexity: O(`maxLength`)
+    public func prefix(_ maxLength: Int) -> [Element] {
+        return (0..<min(maxLength, count)).map { storage[(headIndex + $0) % storage.count]! }
+    }
+
+    /// Removes the first `k` elements, which must exist.
+    ///
+    /// - Complexity: O(`k`) on average
+    public mutating func removeFirst(_ k: Int) {
+        owsPrecondition(k >= 0 && k <= count)
+        for offset in 0..<k {
+            storage[(headIndex + offset) % storage.count] = nil
+        }
+        headIndex = (headIndex + k) % storage.count
+        count -= k
+        if count < storage.count / 4, storage.count / 2 >= minimumCapacity {
+            resize(capacity: storage.count / 2)
+        }
+    }
+
+    public mutating func removeAll() {
+        storage = Array(repeating: nil, count: minimumCapacity)
+        headIndex = 0
+        count = 0
+    }
+
+    private mutating func resize(capacity: Int) {
+        var newStorage = [Element?]()
+        newStorage.reserveCapacity(capacity)
+        for offset in 0..<count {
+            newStorage.append(storage[(headIndex + offset) % storage.count])
+        }
+        newStorage.append(contentsOf: repeatElement(nil, count: capacity - count))
+        storage = newStorage
+        headIndex = 0
+    }
+}
@@ -6,7 +6,7 @@
 import CryptoKit
 import Foundation
 
-public class HmacStreamTransform: StreamTransform, FinalizableStreamTransform, BufferedStreamTransform {
+public class HmacStreamTransform: StreamTransform, BufferPassingStreamTransform, FinalizableStreamTransform, BufferedStreamTransform {
     public enum Error: Swift.Error {
         case invalidHmac
         case invalidFooter
@@ -71,6 +71,15 @@ public class HmacStreamTransform: StreamTransform, FinalizableStreamTransform, B
         return targetData
     }
 
+    public func transform(data: Data, reusing buffer: inout Data) throws -> Data {
+        guard footerSize == 0, inputBuffer.isEmpty else {
+            return try transform(data: data)
+        }
+        // With no footer to hold back, the data passes through unchanged.
+        hmacState.update(data: data)
+        return data
+    }
+
     public func finalize() throws -> Data {
         guard !finalized else { return Data() }
         finalized = true
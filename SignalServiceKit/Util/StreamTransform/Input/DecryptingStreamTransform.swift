@@ -5,7 +5,7 @@
 
 import Foundation
 
-public class DecryptingStreamTransform: StreamTransform, FinalizableStreamTransform {
+public class DecryptingStreamTransform: StreamTransform, BufferPassingStreamTransform, FinalizableStreamTransform {
     public enum Error: Swift.Error {
         case initialBufferTooSmall
         case notInitialized
@@ -26,13 +26,19 @@ public class DecryptingStreamTransform: StreamTransform, FinalizableStreamTransf
     }
 
     public func transform(data: Data) throws -> Data {
+        var buffer = Data()
+        return try transform(data: data, reusing: &buffer)
+    }
+
+    public func transform(data: Data, reusing buffer: inout Data) throws -> Data {
         var inputBuffer = data
         if !hasInitialized {
             guard inputBuffer.count > Constants.HeaderSize else { throw Error.initialBufferTooSmall }
 
             // read the IV
             let iv = inputBuffer.prefix(Constants.HeaderSize)
-            inputBuffer.removeFirst(Constants.HeaderSize)
+            // Slicing, rather than removing, avoids copying the rest.
+            inputBuffer = inputBuffer.dropFirst(Constants.HeaderSize)
             self.cipherContext = try CipherContext(
                 operation: .decrypt,
                 algorithm: .aes,
@@ -42,7 +48,9 @@ public class DecryptingStreamTransform: StreamTransform, FinalizableStreamTransf
             )
             hasInitialized = true
         }
-        return try self.cipherContext?.update(inputBuffer) ?? { throw OWSGenericError("already finalized") }()
+        buffer.count = try self.cipherContext?.outputLength(forUpdateWithInputLength: inputBuffer.count) ?? { throw OWSGenericError("already finalized") }()
+        buffer.count = try self.cipherContext?.update(input: inputBuffer, output: &buffer) ?? 0
+        return buffer
     }
 
     public func finalize() throws -> Data {
@@ -13,6 +13,9 @@ public final class TransformingInputStream {
     private let transforms: [any StreamTransform]
     private let inputStream: InputStream
 
+    /// Reused by each ``BufferPassingStreamTransform`` on every read.
+    private var transformBuffers: [Data]
+
     private var hasInitialized: Bool = false
 
     public init(
@@ -21,6 +24,7 @@ public final class TransformingInputStream {
     ) {
         self.transforms = transforms
         self.inputStream = inputStream
+        self.transformBuffers = Array(repeating: Data(), count: transforms.count)
     }
 
     /// `hasBytesAvailable` should return true if any of the following is true:
@@ -72,7 +76,7 @@ public final class TransformingInputStream {
             }
 
             // Transform the data.
-            returnData = try transforms.reduce(getData()) { try $1.transform(data: $0) }
+            returnData = try transforms.transform(data: getData(), reusing: &transformBuffers)
         }
 
         if returnData.count > 0 {
@@ -5,7 +5,7 @@
 
 import Foundation
 
-public class ChunkedOutputStreamTransform: StreamTransform {
+public class ChunkedOutputStreamTransform: StreamTransform, BufferPassingStreamTransform {
 
     public func transform(data: Data) throws -> Data {
         let byteLength = UInt32(data.count)
@@ -15,6 +15,13 @@ public class ChunkedOutputStreamTransform: StreamTransform {
         return result
     }
 
+    public func transform(data: Data, reusing buffer: inout Data) throws -> Data {
+        buffer.removeAll(keepingCapacity: true)
+        buffer.append(Self.writeVariableLengthUInt32(UInt32(data.count)))
+        buffer.append(data)
+        return buffer
+    }
+
     public static func writeVariableLengthUInt32(_ value: UInt32) -> Data {
         var result = Data()
         var v = value
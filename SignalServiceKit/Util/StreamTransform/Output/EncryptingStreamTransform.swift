@@ -5,7 +5,7 @@
 
 import Foundation
 
-public class EncryptingStreamTransform: StreamTransform, FinalizableStreamTransform {
+public class EncryptingStreamTransform: StreamTransform, BufferPassingStreamTransform, FinalizableStreamTransform {
 
     private var cipherContext: CipherContext?
     private let iv: Data
@@ -36,6 +36,15 @@ public class EncryptingStreamTransform: StreamTransform, FinalizableStreamTransf
         return ciphertextBlock
     }
 
+    public func transform(data: Data, reusing buffer: inout Data) throws -> Data {
+        guard hasWrittenHeader else {
+            return try transform(data: data)
+        }
+        buffer.count = try cipherContext?.outputLength(forUpdateWithInputLength: data.count) ?? { throw OWSGenericError("already finalized") }()
+        buffer.count = try cipherContext?.update(input: data, output: &buffer) ?? 0
+        return buffer
+    }
+
     public func finalize() throws -> Data {
         // Finalize the encryption and write out the last block.
         // Every time we "update" the cipher context, it returns
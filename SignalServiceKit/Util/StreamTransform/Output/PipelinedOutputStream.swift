@@ -0,0 +1,129 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Wrapper around an OutputStreamable that hands data to it on a background
+/// queue, so the downstream work (e.g. the transforms of a
+/// ``TransformingOutputStream``) overlaps with the work of whoever is writing.
+///
+/// Writes are gathered into blocks of at least `blockSize` bytes before being
+/// handed off, so many small writes don't each pay for a dispatch. At most
+/// `maxPendingBlockCount` blocks are in flight; once the downstream falls that
+/// far behind, writes wait for it.
+///
+/// Alternating these with ``TransformingOutputStream``s runs a chain of
+/// transforms as a pipeline, with each group of transforms on its own queue.
+///
+/// An error thrown downstream is rethrown from a later `write(data:)` or from
+/// `close()`; anything written after the error is dropped.
+///
+/// - Important
+/// Like other streams, this must be written to and closed from one thread
+/// at a time.
+public final class PipelinedOutputStream: OutputStreamable {
+
+    private let outputStream: OutputStreamable
+    private let queue: DispatchQueue
+    private let blockSize: Int
+    private let pendingBlockSemaphore: DispatchSemaphore
+    private let downstreamError = TSMutex<Error?>(initialState: nil)
+
+    /// Written data that hasn't been handed to the queue yet.
+    private var pendingBlock = Data()
+
+    public init(
+        outputStream: OutputStreamable,
+        label: String,
+        blockSize: Int = 256 * 1024,
+        maxPendingBlockCount: Int = 4,
+    ) {
+        owsPrecondition(blockSize > 0 && maxPendingBlockCount > 0)
+        self.outputStream = outputStream
+        self.queue = DispatchQueue(label: label, autoreleaseFrequency: .workItem)
+        self.blockSize = blockSize
+        self.pendingBlockSemaphore = DispatchSemaphore(value: maxPendingBlockCount)
+    }
+
+    public func write(data: Data) throws {
+        try throwDownstreamErrorIfNeeded()
+
+        if pendingBlock.isEmpty, data.count >= blockSize {
+            // Already big enough; no need to copy it into the pending block.
+            enqueue(data)
+            return
+        }
+        pendingBlock.append(data)
+        if pendingBlock.count >= blockSize {
+            enqueuePendingBlock()
+        }
+    }
+
+    /// Hands any pending data downstream and waits until it's been written.
+    public func flush() throws {
+        enqueuePendingBlock()
+        queue.sync {}
+        try throwDownstreamErrorIfNeeded()
+    }
+
+    public func close() throws {
+        do {
+            try flush()
+        } catch {
+            // Still close downstream, so its stages are finalized and any
+            // file it writes to isn't leaked; the downstream error wins.
+            queue.sync {
+                try? outputStream.close()
+            }
+            throw error
+        }
+        try queue.sync {
+            try outputStream.close()
+        }
+    }
+
+    private func enqueuePendingBlock() {
+        guard !pendingBlock.isEmpty else {
+            return
+        }
+        let block = pendingBlock
+        pendingBlock = Data(capacity: blockSize)
+        enqueue(block)
+    }
+
+    private func enqueue(_ block: Data) {
+        pendingBlockSemaphore.wait()
+        queue.async { [outputStream, downstreamError, pendingBlockSemaphore] in
+            defer { pendingBlockSemaphore.signal() }
+            guard downstreamError.withLock({ $0 == nil }) else {
+                return
+            }
+            do {
+                try outputStream.write(data: block)
+            } catch {
+                downstreamError.withLock { $0 = $0 ?? error }
+            }
+        }
+    }
+
+    private func throwDownstreamErrorIfNeeded() throws {
+        if let error = downstreamError.withLock({ $0 }) {
+            throw error
+        }
+    }
+
+    // MARK: - OutputStreamable passthrough
+
+    public func remove(from runLoop: RunLoop, forMode mode: RunLoop.Mode) {
+        // Let everything already written reach the stream first.
+        enqueuePendingBlock()
+        queue.sync {}
+        self.outputStream.remove(from: runLoop, forMode: mode)
+    }
+
+    public func schedule(in runLoop: RunLoop, forMode mode: RunLoop.Mode) {
+        self.outputStream.schedule(in: runLoop, forMode: mode)
+    }
+}
@@ -14,6 +14,16 @@ public final class TransformingOutputStream: OutputStreamable {
     private let outputStream: OutputStreamable
     private let runLoop: RunLoop?
 
+    /// Reused by each ``BufferPassingStreamTransform`` on every write.
+    private var transformBuffers: [Data]
+
+    /// Bytes passed to `write(data:)` so far.
+    public private(set) var inputByteCount: UInt64 = 0
+
+    /// Time spent in the transforms so far, not counting writes to the
+    /// output stream.
+    public private(set) var transformDurationNanos: UInt64 = 0
+
     public init(
         transforms: [any StreamTransform],
         outputStream: OutputStreamable,
@@ -22,10 +32,14 @@ public final class TransformingOutputStream: OutputStreamable {
         self.transforms = transforms
         self.outputStream = outputStream
         self.runLoop = runLoop
+        self.transformBuffers = Array(repeating: Data(), count: transforms.count)
     }
 
     public func write(data: Data) throws {
-        let data = try transforms.reduce(data) { try $1.transform(data: $0) }
+        inputByteCount += UInt64(data.count)
+        let startDate = MonotonicDate()
+        let data = try transforms.transform(data: data, reusing: &transformBuffers)
+        transformDurationNanos += (MonotonicDate() - startDate).nanoseconds
         if data.count > 0 {
             try outputStream.write(data: data)
         }
@@ -35,7 +49,9 @@ public final class TransformingOutputStream: OutputStreamable {
     /// footers required by the internal transform implementation.
     public func finalizeAndWriteFooter() throws {
         while hasPendingBytes {
+            let startDate = MonotonicDate()
             let footerData = try transforms.readNextRemainingBytes()
+            transformDurationNanos += (MonotonicDate() - startDate).nanoseconds
             if footerData.count > 0 {
                 try outputStream.write(data: footerData)
             }
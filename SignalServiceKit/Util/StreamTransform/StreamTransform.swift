@@ -26,6 +26,23 @@ public extension StreamTransform {
     var hasPendingBytes: Bool { return false }
 }
 
+/// A stream transform that can write its output into a buffer owned by the
+/// caller, instead of allocating new `Data` on every call.
+///
+/// Passing the same buffer to every call means that once it has grown to fit,
+/// transforming more data doesn't allocate. Transforms that leave the data
+/// unchanged can return their input, which doesn't copy it either.
+public protocol BufferPassingStreamTransform: StreamTransform {
+
+    /// Transform the passed in data, the same as `transform(data:)`.
+    ///
+    /// The result is either `buffer`, with its previous contents replaced, or
+    /// `data` (or a slice of it). Callers should pass the same `buffer` on
+    /// every call, and drop the result before the next call; if it's still
+    /// around, the buffer gets copied rather than reused.
+    func transform(data: Data, reusing buffer: inout Data) throws -> Data
+}
+
 public protocol BufferedStreamTransform {
     /// Returns data buffered by the transform. Depending on internal
     /// implementations this may return all or just part of the buffered data.
@@ -49,6 +66,27 @@ public protocol FinalizableStreamTransform {
     var hasFinalized: Bool { get }
 }
 
+public extension Array where Element == any StreamTransform {
+    /// Pass `data` through each transform in turn.
+    ///
+    /// Any ``BufferPassingStreamTransform`` writes into its buffer in
+    /// `buffers`, which must have one (initially empty) buffer per transform,
+    /// and is reused across calls. Other transforms allocate their output
+    /// as usual.
+    func transform(data: Data, reusing buffers: inout [Data]) throws -> Data {
+        owsPrecondition(buffers.count == count)
+        var data = data
+        for (index, transform) in self.enumerated() {
+            if let transform = transform as? BufferPassingStreamTransform {
+                data = try transform.transform(data: data, reusing: &buffers[index])
+            } else {
+                data = try transform.transform(data: data)
+            }
+        }
+        return data
+    }
+}
+
 /// Read any available bytes remaining in the list of transforms including
 /// any buffered data or pending footer data.
 ///
@@ -149,7 +149,7 @@ private class DeviceMessageBuilderMock: DeviceMessageBuilder {
         serviceId: ServiceId,
         isSelfSend: Bool,
         encryptionStyle: EncryptionStyle,
-        buildPlaintextContent: (DeviceId, DBWriteTransaction) throws -> Data,
+        buildPlaintextContent: @escaping (DeviceId, DBWriteTransaction) throws -> Data,
         isTransient: Bool,
         sealedSenderParameters: SealedSenderParameters?,
         localAci: Aci,
@@ -121,6 +121,37 @@ class GroupModelsTest: SSKBaseTest {
         XCTAssertEqual(membership4, membership5)
     }
 
+    func testGroupMembershipShowInfoMessageForChangedMembers() {
+        var builder1 = GroupMembership.Builder()
+        builder1.addFullMember(.aci1, role: .administrator)
+        builder1.addFullMember(.aci2, role: .normal)
+        let membership1 = builder1.build()
+
+        // Joining via an invite link isn't a change worth a message.
+        var builder2 = membership1.asBuilder
+        builder2.remove(Aci.aci2)
+        builder2.addFullMember(.aci2, role: .normal, didJoinFromInviteLink: true)
+        let membership2 = builder2.build()
+
+        var builder3 = membership1.asBuilder
+        builder3.remove(Aci.aci2)
+        builder3.addFullMember(.aci2, role: .administrator)
+        let membership3 = builder3.build()
+
+        var builder4 = membership1.asBuilder
+        builder4.addRequestingMember(Aci.aci3)
+        let membership4 = builder4.build()
+
+        for changedMemberServiceIds: Set<ServiceId>? in [nil, [Aci.aci2, Aci.aci3]] {
+            XCTAssertFalse(membership2.showInfoMessageForChangeComparedTo(to: membership1, changedMemberServiceIds: changedMemberServiceIds))
+            XCTAssertTrue(membership3.showInfoMessageForChangeComparedTo(to: membership1, changedMemberServiceIds: changedMemberServiceIds))
+            XCTAssertTrue(membership4.showInfoMessageForChangeComparedTo(to: membership1, changedMemberServiceIds: changedMemberServiceIds))
+        }
+
+        // Only the members said to have changed are compared.
+        XCTAssertFalse(membership3.showInfoMessageForChangeComparedTo(to: membership1, changedMemberServiceIds: [Aci.aci1]))
+    }
+
     func testTSGroupModelBackwardsCompatibleDeserialization() throws {
         let groupIdLength = 16 // Taken from kGroupIdLength at the time of archiving.
         let expectedGroupId = Data(repeating: 8, count: groupIdLength)
@@ -230,4 +261,190 @@ class GroupModelsTest: SSKBaseTest {
             XCTAssertEqual(groupModel.isTerminated, false)
         }
     }
+
+    func testGroupMembershipPartitions() throws {
+        let admin = Aci.randomForTesting()
+        let fullMember = Aci.randomForTesting()
+        let invitedPni = Pni.randomForTesting()
+        let requester = Aci.randomForTesting()
+        let stranger = Aci.randomForTesting()
+
+        var builder = GroupMembership.Builder()
+        builder.addFullMember(admin, role: .administrator)
+        builder.addFullMember(fullMember, role: .normal)
+        builder.addInvitedMember(invitedPni, role: .administrator, addedByAci: admin)
+        builder.addRequestingMember(requester)
+        let membership = builder.build()
+
+        // Archiving builds the partitions again from the decoded members.
+        let archivedData = try NSKeyedArchiver.archivedData(withRootObject: membership, requiringSecureCoding: true)
+        let unarchivedMembership = try XCTUnwrap(NSKeyedUnarchiver.unarchivedObject(ofClass: GroupMembership.self, from: archivedData))
+
+        for membership in [membership, unarchivedMembership] {
+            XCTAssertEqual(membership.fullMembers, [SignalServiceAddress(admin), SignalServiceAddress(fullMember)])
+            XCTAssertEqual(membership.fullMemberAdministrators, [SignalServiceAddress(admin)])
+            XCTAssertEqual(membership.invitedMembers, [SignalServiceAddress(invitedPni)])
+            XCTAssertEqual(membership.requestingMembers, [SignalServiceAddress(requester)])
+            XCTAssertEqual(membership.allMembersOfAnyKindServiceIds, [admin, fullMember, invitedPni, requester])
+
+            XCTAssertEqual(membership.role(for: admin), .administrator)
+            XCTAssertEqual(membership.role(for: invitedPni), .administrator)
+            XCTAssertEqual(membership.role(for: requester), .normal)
+            XCTAssertNil(membership.role(for: stranger))
+
+            XCTAssertTrue(membership.isFullMemberAndAdministrator(admin))
+            XCTAssertFalse(membership.isFullMemberAndAdministrator(invitedPni))
+            XCTAssertTrue(membership.isFullMember(fullMember))
+            XCTAssertTrue(membership.isInvitedMember(invitedPni))
+            XCTAssertEqual(membership.addedByAci(forInvitedMember: invitedPni), admin)
+            XCTAssertTrue(membership.isRequestingMember(requester))
+            XCTAssertFalse(membership.isMemberOfAnyKind(stranger))
+            XCTAssertFalse(membership.hasProfileKeyInGroup(serviceId: invitedPni))
+            XCTAssertFalse(membership.canViewProfileKeys(serviceId: requester))
+        }
+    }
+
+    /// Runs the queries a send and the member list make, against a group
+    /// with a thousand members.
+    func testGroupMembershipQueryPerformance() {
+        let admins = (0..<10).map { _ in Aci.randomForTesting() }
+        let fullMembers = (0..<890).map { _ in Aci.randomForTesting() }
+        let invitedMembers = (0..<50).map { _ in Pni.randomForTesting() }
+        let requestingMembers = (0..<50).map { _ in Aci.randomForTesting() }
+        let strangers = (0..<100).map { _ in Aci.randomForTesting() }
+
+        var builder = GroupMembership.Builder()
+        admins.forEach { builder.addFullMember($0, role: .administrator) }
+        fullMembers.forEach { builder.addFullMember($0, role: .normal) }
+        invitedMembers.forEach { builder.addInvitedMember($0, role: .normal, addedByAci: admins[0]) }
+        requestingMembers.forEach { builder.addRequestingMember($0) }
+        let membership = builder.build()
+
+        let queriedServiceIds: [ServiceId] = [
+            admins as [ServiceId],
+            fullMembers as [ServiceId],
+            invitedMembers as [ServiceId],
+            requestingMembers as [ServiceId],
+            strangers as [ServiceId],
+        ].flatMap { $0 }
+
+        measure {
+            var matchCount = 0
+            for _ in 0..<10 {
+                matchCount += membership.fullMembers.count
+                matchCount += membership.fullMemberAdministrators.count
+                matchCount += membership.allMembersOfAnyKindServiceIds.count
+                for serviceId in queriedServiceIds {
+                    if membership.isMemberOfAnyKind(serviceId) { matchCount += 1 }
+                    if membership.isFullMember(serviceId) { matchCount += 1 }
+                    if membership.role(for: serviceId) == .administrator { matchCount += 1 }
+                }
+            }
+            XCTAssertEqual(matchCount, 10 * (900 + 10 + 1000 + 1000 + 900 + 10))
+        }
+    }
+
+    private func makeMembershipForArchiving() -> GroupMembership {
+        var builder = GroupMembership.Builder()
+        builder.addFullMember(.aci1, role: .administrator)
+        builder.addFullMember(.aci2, role: .normal, didJoinFromInviteLink: true)
+        builder.addFullMember(.aci3, role: .normal, didJoinFromAcceptedJoinRequest: true)
+        builder.addInvitedMember(Pni.randomForTesting(), role: .administrator, addedByAci: .aci1)
+        builder.addInvitedMember(Aci.randomForTesting(), role: .normal, addedByAci: .aci2)
+        builder.addRequestingMember(Aci.randomForTesting())
+        builder.addBannedMember(Aci.randomForTesting(), bannedAtTimestamp: 1_700_000_000_000)
+        builder.addInvalidInvite(userId: Data(repeating: 1, count: 32), addedByUserId: Data(repeating: 2, count: 32))
+        builder.setMemberLabel(label: MemberLabel(label: "Organizer", labelEmoji: "🗓️"), aci: .aci1)
+        builder.setMemberLabel(label: MemberLabel(label: "Treasurer", labelEmoji: nil), aci: .aci2)
+        return builder.build()
+    }
+
+    private func assertMembershipsMatch(
+        _ membership: GroupMembership,
+        _ otherMembership: GroupMembership,
+        file: StaticString = #filePath,
+        line: UInt = #line,
+    ) {
+        XCTAssertEqual(membership, otherMembership, file: file, line: line)
+        // Equality ignores how members joined.
+        for address in membership.fullMembers {
+            XCTAssertEqual(
+                membership.didJoinFromInviteLink(forFullMember: address),
+                otherMembership.didJoinFromInviteLink(forFullMember: address),
+                file: file,
+                line: line,
+            )
+            XCTAssertEqual(
+                membership.didJoinFromAcceptedJoinRequest(forFullMember: address),
+                otherMembership.didJoinFromAcceptedJoinRequest(forFullMember: address),
+                file: file,
+                line: line,
+            )
+        }
+    }
+
+    private func archiveCompact(_ membership: GroupMembership) throws -> Data {
+        let archiver = NSKeyedArchiver(requiringSecureCoding: true)
+        XCTAssertTrue(membership.encodeCompact(with: archiver))
+        archiver.finishEncoding()
+        return archiver.encodedData
+    }
+
+    func testGroupMembershipCompactArchiving() throws {
+        let membership = makeMembershipForArchiving()
+
+        let unarchiver = try NSKeyedUnarchiver(forReadingFrom: try archiveCompact(membership))
+        let unarchivedMembership = try XCTUnwrap(GroupMembership(coder: unarchiver))
+        assertMembershipsMatch(membership, unarchivedMembership)
+        XCTAssertEqual(unarchivedMembership.memberLabel(for: .aci1), MemberLabel(label: "Organizer", labelEmoji: "🗓️"))
+        XCTAssertEqual(unarchivedMembership.memberLabel(for: .aci2), MemberLabel(label: "Treasurer", labelEmoji: nil))
+    }
+
+    func testGroupMembershipKeyedArchiving() throws {
+        let membership = makeMembershipForArchiving()
+
+        // Until the compact writer is turned on, memberships are archived in
+        // the keyed form, which older builds can read.
+        let archiver = NSKeyedArchiver(requiringSecureCoding: true)
+        membership.encode(with: archiver)
+        archiver.finishEncoding()
+        let unarchiver = try NSKeyedUnarchiver(forReadingFrom: archiver.encodedData)
+        XCTAssertTrue(unarchiver.containsValue(forKey: "memberStates"))
+        XCTAssertFalse(unarchiver.containsValue(forKey: "compactContents"))
+        let unarchivedMembership = try XCTUnwrap(GroupMembership(coder: unarchiver))
+        assertMembershipsMatch(membership, unarchivedMembership)
+
+        // Members without a service ID can only be archived in the keyed form.
+        let v1CompactArchiver = NSKeyedArchiver(requiringSecureCoding: true)
+        XCTAssertFalse(GroupMembership(membersForTest: [SignalServiceAddress(phoneNumber: "+16505550100")]).encodeCompact(with: v1CompactArchiver))
+        let v1Membership = GroupMembership(membersForTest: [SignalServiceAddress.randomForTesting(), SignalServiceAddress(phoneNumber: "+16505550100")])
+        let v1ArchivedData = try NSKeyedArchiver.archivedData(withRootObject: v1Membership, requiringSecureCoding: true)
+        let v1UnarchivedMembership = try XCTUnwrap(NSKeyedUnarchiver.unarchivedObject(ofClass: GroupMembership.self, from: v1ArchivedData))
+        XCTAssertEqual(v1Membership, v1UnarchivedMembership)
+    }
+
+    /// Unarchives a group with a thousand members, logging the size of the
+    /// compact and keyed archives.
+    func testGroupMembershipArchivingPerformance() throws {
+        var builder = GroupMembership.Builder()
+        let admin = Aci.randomForTesting()
+        builder.addFullMember(admin, role: .administrator)
+        (0..<899).forEach { _ in builder.addFullMember(Aci.randomForTesting(), role: .normal) }
+        (0..<50).forEach { _ in builder.addInvitedMember(Pni.randomForTesting(), role: .normal, addedByAci: admin) }
+        (0..<50).forEach { _ in builder.addRequestingMember(Aci.randomForTesting()) }
+        let membership = builder.build()
+
+        let archivedData = try archiveCompact(membership)
+        let keyedArchiver = NSKeyedArchiver(requiringSecureCoding: true)
+        membership.encodeKeyed(with: keyedArchiver)
+        keyedArchiver.finishEncoding()
+        Logger.info("Archived a thousand members in \(archivedData.count) bytes; \(keyedArchiver.encodedData.count) bytes in the keyed form.")
+
+        measure {
+            for _ in 0..<10 {
+                let unarchivedMembership = GroupMembership(coder: try! NSKeyedUnarchiver(forReadingFrom: archivedData))
+                XCTAssertEqual(unarchivedMembership?.allMembersOfAnyKind.count, 1000)
+            }
+        }
+    }
 }
@@ -0,0 +1,189 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import LibSignalClient
+import XCTest
+
+@testable import SignalServiceKit
+
+final class GroupSendEndorsementCacheTest: XCTestCase {
+    private var db: InMemoryDB!
+    private var cache: GroupSendEndorsementCache!
+    private var groupRowId: GroupRecord.RowId!
+
+    private let groupSendEndorsementStore = GroupSendEndorsementStore()
+    private let recipientDatabaseTable = RecipientDatabaseTable()
+    private let serverSecretParams = try! ServerSecretParams.generate()
+    private let secretParams = try! GroupSecretParams.generate()
+    private let localAci = Aci.randomForTesting()
+    private let otherAcis = (0..<4).map { _ in Aci.randomForTesting() }
+
+    /// Endorsements expire at the start of a day.
+    private let expiration = Date(timeIntervalSince1970: floor(Date().timeIntervalSince1970 / .day) * .day + 2 * .day)
+
+    override func setUp() {
+        super.setUp()
+        db = InMemoryDB()
+        cache = GroupSendEndorsementCache(
+            groupSendEndorsementStore: groupSendEndorsementStore,
+            recipientDatabaseTable: recipientDatabaseTable,
+        )
+        groupRowId = db.write { tx in
+            return GroupRecord.insertRecord(
+                groupId: try! secretParams.getPublicParams().getGroupIdentifier().serialize(),
+                threadId: nil,
+                masterKey: try! secretParams.getMasterKey(),
+                tx: tx,
+            ).rowId
+        }
+    }
+
+    /// Issues endorsements as the server would, and saves them as
+    /// `GroupsV2Impl` does.
+    private func saveEndorsements(members: [Aci], expiration: Date) throws {
+        let groupMembers = [localAci] + members
+        let cipher = ClientZkGroupCipher(groupSecretParams: secretParams)
+        let response = GroupSendEndorsementsResponse.issue(
+            groupMembers: try groupMembers.map { try cipher.encrypt($0) },
+            keyPair: GroupSendDerivedKeyPair.forExpiration(expiration, params: serverSecretParams),
+        )
+        let receivedEndorsements = try response.receive(
+            groupMembers: groupMembers,
+            localUser: localAci,
+            groupParams: secretParams,
+            serverParams: try serverSecretParams.getPublicParams(),
+        )
+        db.write { tx in
+            groupSendEndorsementStore.saveEndorsements(
+                groupRowId: groupRowId,
+                expiration: response.expiration,
+                combinedEndorsement: receivedEndorsements.combinedEndorsement,
+                individualEndorsements: zip(groupMembers, receivedEndorsements.endorsements).dropFirst().map { aci, endorsement in
+                    return (recipientId(for: aci, tx: tx), endorsement)
+                },
+                tx: tx,
+            )
+        }
+    }
+
+    private func recipientId(for aci: Aci, tx: DBWriteTransaction) -> SignalRecipient.RowId {
+        if let recipient = recipientDatabaseTable.fetchRecipient(serviceId: aci, transaction: tx) {
+            return recipient.id
+        }
+        return try! SignalRecipient.insertRecord(aci: aci, tx: tx).id
+    }
+
+    private func fetchEndorsements() throws -> GroupSendEndorsements? {
+        return try db.read { tx in
+            return try cache.fetchEndorsements(groupRowId: groupRowId, secretParams: secretParams, tx: tx)
+        }
+    }
+
+    func testNoEndorsements() throws {
+        XCTAssertNil(try fetchEndorsements())
+
+        try saveEndorsements(members: Array(otherAcis.prefix(2)), expiration: expiration)
+        XCTAssertNotNil(try fetchEndorsements())
+        db.write { tx in groupSendEndorsementStore.deleteEndorsements(groupRowId: groupRowId, tx: tx) }
+        XCTAssertNil(try fetchEndorsements())
+    }
+
+    func testReusesEntry() throws {
+        try saveEndorsements(members: Array(otherAcis.prefix(3)), expiration: expiration)
+
+        let endorsements = try XCTUnwrap(try fetchEndorsements())
+        XCTAssertEqual(Set(endorsements.individual.keys), Set(otherAcis.prefix(3)))
+        XCTAssertEqual(endorsements.expiration, expiration)
+        let cachedEndorsements = try XCTUnwrap(try fetchEndorsements())
+        XCTAssertEqual(cachedEndorsements.combined.serialize(), endorsements.combined.serialize())
+
+        let metrics = cache.metrics
+        XCTAssertEqual(metrics.hitCount, 1)
+        XCTAssertEqual(metrics.buildCount, 1)
+        XCTAssertEqual(metrics.decodedEndorsementCount, 3)
+        XCTAssertEqual(metrics.reusedEndorsementCount, 0)
+    }
+
+    func testRebuildsAfterMembershipChange() throws {
+        try saveEndorsements(members: Array(otherAcis.prefix(3)), expiration: expiration)
+        let oldEndorsements = try XCTUnwrap(try fetchEndorsements())
+
+        // Members' endorsements don't change when someone else joins.
+        try saveEndorsements(members: otherAcis, expiration: expiration)
+        let endorsements = try XCTUnwrap(try fetchEndorsements())
+        XCTAssertEqual(Set(endorsements.individual.keys), Set(otherAcis))
+        XCTAssertNotEqual(endorsements.combined.serialize(), oldEndorsements.combined.serialize())
+
+        let metrics = cache.metrics
+        XCTAssertEqual(metrics.hitCount, 0)
+        XCTAssertEqual(metrics.buildCount, 2)
+        XCTAssertEqual(metrics.decodedEndorsementCount, 3 + 1)
+        XCTAssertEqual(metrics.reusedEndorsementCount, 3)
+    }
+
+    func testRebuildsAfterExpirationChange() throws {
+        try saveEndorsements(members: otherAcis, expiration: expiration)
+        _ = try fetchEndorsements()
+
+        // Endorsements for a new expiration are all new.
+        let newExpiration = expiration.addingTimeInterval(.day)
+        try saveEndorsements(members: otherAcis, expiration: newExpiration)
+        let endorsements = try XCTUnwrap(try fetchEndorsements())
+        XCTAssertEqual(endorsements.expiration, newExpiration)
+
+        let metrics = cache.metrics
+        XCTAssertEqual(metrics.buildCount, 2)
+        XCTAssertEqual(metrics.decodedEndorsementCount, 2 * otherAcis.count)
+        XCTAssertEqual(metrics.reusedEndorsementCount, 0)
+    }
+
+    func testCombinedTokenExcludingMembers() throws {
+        try saveEndorsements(members: otherAcis, expiration: expiration)
+        let endorsements = try XCTUnwrap(try fetchEndorsements())
+
+        let excludedAcis: Set<ServiceId> = [otherAcis[0], otherAcis[1]]
+        let expectedEndorsement = endorsements.combined
+            .byRemoving(endorsements.individual[otherAcis[0]]!)
+            .byRemoving(endorsements.individual[otherAcis[1]]!)
+        for _ in 0..<2 {
+            XCTAssertEqual(
+                endorsements.combinedTokenBuilder(excluding: excludedAcis).endorsement.serialize(),
+                expectedEndorsement.serialize(),
+            )
+        }
+        XCTAssertEqual(
+            endorsements.combinedTokenBuilder(excluding: []).endorsement.serialize(),
+            endorsements.combined.serialize(),
+        )
+    }
+
+    func testCombinedExcludingCache() throws {
+        try saveEndorsements(members: otherAcis, expiration: expiration)
+        let endorsements = try XCTUnwrap(try fetchEndorsements())
+
+        let combinedExcludingCache = CombinedExcludingCache()
+        var buildCount = 0
+        func endorsement(excluding excludedServiceIds: Set<ServiceId>) -> GroupSendEndorsement {
+            return combinedExcludingCache.endorsement(excluding: excludedServiceIds) {
+                buildCount += 1
+                return endorsements.combined
+            }
+        }
+
+        _ = endorsement(excluding: [otherAcis[0]])
+        _ = endorsement(excluding: [otherAcis[0]])
+        XCTAssertEqual(buildCount, 1)
+        _ = endorsement(excluding: [otherAcis[1]])
+        XCTAssertEqual(buildCount, 2)
+
+        // It only keeps a few results.
+        for aci in otherAcis.prefix(CombinedExcludingCache.maxCount) {
+            _ = endorsement(excluding: [aci, localAci])
+        }
+        buildCount = 0
+        _ = endorsement(excluding: [otherAcis[0]])
+        XCTAssertEqual(buildCount, 1)
+    }
+}
@@ -106,6 +106,55 @@ final class JobQueueRunnerTest: XCTestCase {
         serialRunner.start(shouldRestartExistingJobs: false)
         guard case .notFound = await result else { XCTFail("Shouldn't find JobRecord."); return }
     }
+
+    func testRecordChangesLeftToRunner() async throws {
+        concurrentRunner.start(shouldRestartExistingJobs: false)
+        let job1 = SessionResetJobRecord(contactThreadId: "A")
+        jobFinder.addJob(job1)
+        async let result1: JobResult = withCheckedContinuation { continuation in
+            concurrentRunner.addPersistedJob(job1, runner: jobRunnerFactory.buildRunner(completionContinuation: continuation, outcome: .finishedPendingRemoval))
+        }
+        let job2 = SessionResetJobRecord(contactThreadId: "B")
+        jobFinder.addJob(job2)
+        async let result2: JobResult = withCheckedContinuation { continuation in
+            concurrentRunner.addPersistedJob(job2, runner: jobRunnerFactory.buildRunner(completionContinuation: continuation, outcome: .failed))
+        }
+        guard case .ranJob(.success) = await result1 else { XCTFail("Should succeed."); return }
+        guard case .ranJob(.failure) = await result2 else { XCTFail("Should fail."); return }
+        try mockDb.read { tx in
+            XCTAssertNil(try jobFinder.fetchJob(rowId: job1.id!, tx: tx))
+            XCTAssertNil(try jobFinder.fetchJob(rowId: job2.id!, tx: tx))
+        }
+    }
+
+    /// Logs how long it takes to run many concurrent jobs when each removes
+    /// its own record and when the runner removes them together.
+    func testRecordRemovalThroughput() async {
+        func runJobs(count: Int, outcome: MockJobRunner.Outcome) async -> TimeInterval {
+            let runner = JobQueueRunner(canExecuteJobsConcurrently: true, db: mockDb, jobFinder: jobFinder, jobRunnerFactory: jobRunnerFactory)
+            runner.start(shouldRestartExistingJobs: false)
+            let startDate = MonotonicDate()
+            await withTaskGroup(of: Void.self) { taskGroup in
+                for index in 0..<count {
+                    let job = SessionResetJobRecord(contactThreadId: "\(index)")
+                    jobFinder.addJob(job)
+                    taskGroup.addTask {
+                        _ = await withCheckedContinuation { continuation in
+                            runner.addPersistedJob(job, runner: self.jobRunnerFactory.buildRunner(completionContinuation: continuation, outcome: outcome))
+                        }
+                    }
+                }
+            }
+            return (MonotonicDate() - startDate).seconds
+        }
+
+        for count in [10, 100, 1000] {
+            let separateDuration = await runJobs(count: count, outcome: .finished)
+            let batchedDuration = await runJobs(count: count, outcome: .finishedPendingRemoval)
+            Logger.info("Ran \(count) concurrent jobs in \(Int(batchedDuration * 1000))ms with batched removal; \(Int(separateDuration * 1000))ms with separate removal.")
+        }
+        XCTAssertEqual(jobRunnerFactory.executedJobs.count, 2 * (10 + 100 + 1000))
+    }
 }
 
 private class MockJobFinder: JobRecordFinder {
@@ -154,6 +203,7 @@ private class MockJobRunnerFactory: JobRunnerFactory {
     func buildRunner(
         completionContinuation: CheckedContinuation<JobResult<Void>, Never>? = nil,
         retryInterval: TimeInterval? = nil,
+        outcome: MockJobRunner.Outcome = .finished,
     ) -> MockJobRunner {
         return MockJobRunner(
             completionContinuation: completionContinuation,
@@ -161,16 +211,26 @@ private class MockJobRunnerFactory: JobRunnerFactory {
             jobFinder: jobFinder,
             mockDb: mockDb,
             retryInterval: retryInterval,
+            outcome: outcome,
         )
     }
 }
 
 private class MockJobRunner: JobRunner {
+    enum Outcome {
+        /// Removes its own record and returns `.finished`.
+        case finished
+        case finishedPendingRemoval
+        /// Returns `.failed` with a terminal error.
+        case failed
+    }
+
     let completionContinuation: CheckedContinuation<JobResult<Void>, Never>?
     let executedJobs: AtomicArray<String>
     let jobFinder: MockJobFinder
     let mockDb: InMemoryDB
     var retryInterval: TimeInterval?
+    let outcome: Outcome
 
     init(
         completionContinuation: CheckedContinuation<JobResult<Void>, Never>?,
@@ -178,12 +238,14 @@ private class MockJobRunner: JobRunner {
         jobFinder: MockJobFinder,
         mockDb: InMemoryDB,
         retryInterval: TimeInterval?,
+        outcome: Outcome,
     ) {
         self.completionContinuation = completionContinuation
         self.executedJobs = executedJobs
         self.jobFinder = jobFinder
         self.mockDb = mockDb
         self.retryInterval = retryInterval
+        self.outcome = outcome
     }
 
     func runJobAttempt(_ jobRecord: SessionResetJobRecord) async -> JobAttemptResult<Void> {
@@ -191,9 +253,15 @@ private class MockJobRunner: JobRunner {
         if let retryInterval = self.retryInterval {
             self.retryInterval = nil
             return .retryAfter(retryInterval)
-        } else {
+        }
+        switch outcome {
+        case .finished:
             await mockDb.awaitableWrite { tx in self.jobFinder.removeJob(jobRecord, tx: tx) }
             return .finished(.success(()))
+        case .finishedPendingRemoval:
+            return .finishedPendingRemoval(.success(()))
+        case .failed:
+            return .failed(OWSGenericError("Terminal failure."), retryLimit: 0)
         }
     }
 
@@ -0,0 +1,102 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+final class MaintenanceSchedulerTest: XCTestCase {
+    private var db: InMemoryDB!
+    private let kvStore = KeyValueStore(collection: "MaintenanceSchedulerTest")
+
+    /// One step per slice, with no pauses.
+    private let sliceEveryStep = MaintenanceScheduler.Budget(writeLockDuration: 0, pauseBetweenSlices: 0)
+
+    override func setUp() {
+        super.setUp()
+        db = InMemoryDB()
+        db.write { tx in
+            for value in 0..<12 {
+                kvStore.setInt(value, key: "\(value)", transaction: tx)
+            }
+        }
+    }
+
+    /// Deletes one value per step.
+    private func deleteOneValue(tx: DBWriteTransaction) -> MaintenanceScheduler.StepResult {
+        guard let key = kvStore.allKeys(transaction: tx).first else {
+            return .done
+        }
+        kvStore.removeValue(forKey: key, transaction: tx)
+        return .more
+    }
+
+    func testRunUntilDone() async {
+        let scheduler = MaintenanceScheduler(db: db)
+        await scheduler.runUntilDone(name: "test", budget: sliceEveryStep, step: deleteOneValue(tx:))
+
+        db.read { tx in XCTAssertEqual(kvStore.allKeys(transaction: tx), []) }
+        let cost = scheduler.costs()["test"]!
+        XCTAssertEqual(cost.runCount, 1)
+        XCTAssertEqual(cost.stepCount, 13)
+        XCTAssertEqual(cost.sliceMicros.count, 13)
+        XCTAssertEqual(cost.rowsWritten, 12)
+    }
+
+    func testRunDueTasksWithinBudget() async {
+        let scheduler = MaintenanceScheduler(db: db)
+        var budget = sliceEveryStep
+        budget.rowsWrittenPerPass = 5
+        scheduler.register(uniqueKey: .cleanUpMessageSendLog, approximateInterval: .day, budget: budget, step: deleteOneValue(tx:))
+
+        func remainingCount() -> Int {
+            return db.read { tx in kvStore.allKeys(transaction: tx).count }
+        }
+
+        // Out of budget after 5 rows, so it's still due.
+        await scheduler.runDueTasks()
+        XCTAssertEqual(remainingCount(), 7)
+        await scheduler.runDueTasks()
+        XCTAssertEqual(remainingCount(), 2)
+        await scheduler.runDueTasks()
+        XCTAssertEqual(remainingCount(), 0)
+
+        // Finished, so it's not due again for a day.
+        await scheduler.runDueTasks()
+
+        let cost = scheduler.costs()["cleanUpMessageSendLog"]!
+        XCTAssertEqual(cost.runCount, 3)
+        XCTAssertEqual(cost.overBudgetCount, 2)
+        XCTAssertEqual(cost.rowsWritten, 12)
+    }
+
+    func testRunDueTasksStopsWhenCancelled() async {
+        let scheduler = MaintenanceScheduler(db: db)
+        scheduler.register(uniqueKey: .cleanUpMessageSendLog, approximateInterval: .day, budget: sliceEveryStep) { tx in
+            let stepResult = self.deleteOneValue(tx: tx)
+            // Cancelled (eg when background time runs out) partway through.
+            if self.kvStore.allKeys(transaction: tx).count == 9 {
+                withUnsafeCurrentTask { $0?.cancel() }
+            }
+            return stepResult
+        }
+
+        func remainingCount() -> Int {
+            return db.read { tx in kvStore.allKeys(transaction: tx).count }
+        }
+
+        await Task { await scheduler.runDueTasks() }.value
+        XCTAssertEqual(remainingCount(), 9)
+
+        // It wasn't finished, so the next pass continues.
+        await Task { await scheduler.runDueTasks() }.value
+        XCTAssertEqual(remainingCount(), 0)
+
+        let cost = scheduler.costs()["cleanUpMessageSendLog"]!
+        XCTAssertEqual(cost.runCount, 2)
+        XCTAssertEqual(cost.overBudgetCount, 0)
+    }
+}
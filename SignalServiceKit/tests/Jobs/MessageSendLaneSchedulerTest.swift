@@ -0,0 +1,147 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+final class MessageSendLaneSchedulerTest: XCTestCase {
+
+    private typealias Lane = MessageSendLaneScheduler.Lane
+
+    /// Starts a send that holds its slot until the returned continuation is
+    /// resumed, and waits for it to get the slot (or start waiting for one).
+    private func startHeldSend(
+        scheduler: MessageSendLaneScheduler,
+        lane: Lane,
+        conversationId: String,
+        expectedWaiterCount: Int = 0,
+        completions: TSMutex<[String]>,
+    ) async -> (CancellableContinuation<Void>, Task<Void, Never>) {
+        let releaseContinuation = CancellableContinuation<Void>()
+        let didStart = CancellableContinuation<Void>()
+        let task = Task {
+            await scheduler.run(lane: lane, conversationId: conversationId) {
+                didStart.resume(with: .success(()))
+                try? await releaseContinuation.wait()
+                completions.withLock { $0.append(conversationId) }
+            }
+        }
+        if expectedWaiterCount > 0 {
+            while scheduler.waiterCount(lane: lane) < expectedWaiterCount {
+                await Task.yield()
+            }
+        } else {
+            try? await didStart.wait()
+        }
+        return (releaseContinuation, task)
+    }
+
+    func testBudgetIsRespected() async {
+        let scheduler = MessageSendLaneScheduler(slotCounts: [.text: 2, .media: 1, .sync: 1])
+        let activeCount = TSMutex(initialState: (current: 0, max: 0))
+        await withTaskGroup(of: Void.self) { taskGroup in
+            for index in 0..<20 {
+                taskGroup.addTask {
+                    await scheduler.run(lane: .text, conversationId: "\(index % 4)") {
+                        activeCount.withLock { $0.current += 1; $0.max = max($0.max, $0.current) }
+                        try? await Task.sleep(nanoseconds: 2 * NSEC_PER_MSEC)
+                        activeCount.withLock { $0.current -= 1 }
+                    }
+                }
+            }
+        }
+        XCTAssertEqual(activeCount.withLock { $0.max }, 2)
+        XCTAssertEqual(scheduler.queueLatencies()[.text]?.count, 20)
+    }
+
+    func testLanesAreIndependent() async {
+        let scheduler = MessageSendLaneScheduler(slotCounts: [.text: 1, .media: 1, .sync: 1])
+        let completions = TSMutex(initialState: [String]())
+        let (releaseMedia, mediaTask) = await startHeldSend(scheduler: scheduler, lane: .media, conversationId: "media", completions: completions)
+
+        // Text sends don't wait for a busy media lane.
+        await scheduler.run(lane: .text, conversationId: "text") {
+            completions.withLock { $0.append("text") }
+        }
+
+        releaseMedia.resume(with: .success(()))
+        await mediaTask.value
+        XCTAssertEqual(completions.withLock { $0 }, ["text", "media"])
+    }
+
+    func testSlotsGoToLeastBusyConversation() async {
+        let scheduler = MessageSendLaneScheduler(slotCounts: [.text: 2, .media: 1, .sync: 1])
+        let completions = TSMutex(initialState: [String]())
+
+        let (releaseA1, taskA1) = await startHeldSend(scheduler: scheduler, lane: .text, conversationId: "A", completions: completions)
+        let (releaseX, taskX) = await startHeldSend(scheduler: scheduler, lane: .text, conversationId: "X", completions: completions)
+        let (releaseA2, taskA2) = await startHeldSend(scheduler: scheduler, lane: .text, conversationId: "A", expectedWaiterCount: 1, completions: completions)
+        let (releaseB, taskB) = await startHeldSend(scheduler: scheduler, lane: .text, conversationId: "B", expectedWaiterCount: 2, completions: completions)
+
+        // "A" already has a send running, so "B" gets the freed slot even
+        // though "A" has been waiting longer.
+        releaseX.resume(with: .success(()))
+        await taskX.value
+        while scheduler.waiterCount(lane: .text) > 1 {
+            await Task.yield()
+        }
+        releaseB.resume(with: .success(()))
+        await taskB.value
+
+        releaseA1.resume(with: .success(()))
+        await taskA1.value
+        releaseA2.resume(with: .success(()))
+        await taskA2.value
+
+        XCTAssertEqual(completions.withLock { $0 }, ["X", "B", "A", "A"])
+    }
+
+    /// Runs a burst of text sends across many conversations alongside slow
+    /// media sends, logging how long each kind waited for a slot. For
+    /// comparison, also runs the same load with a single shared budget.
+    func testSyntheticLoad() async {
+        func runLoad(scheduler: MessageSendLaneScheduler, mediaLane: Lane) async -> [Lane: MessageSendLaneScheduler.Histogram] {
+            await withTaskGroup(of: Void.self) { taskGroup in
+                for index in 0..<30 {
+                    taskGroup.addTask {
+                        await scheduler.run(lane: mediaLane, conversationId: "media-\(index % 3)") {
+                            try? await Task.sleep(nanoseconds: 50 * NSEC_PER_MSEC)
+                        }
+                    }
+                }
+                for index in 0..<300 {
+                    taskGroup.addTask {
+                        await scheduler.run(lane: .text, conversationId: "text-\(index % 30)") {
+                            try? await Task.sleep(nanoseconds: 2 * NSEC_PER_MSEC)
+                        }
+                    }
+                }
+            }
+            return scheduler.queueLatencies()
+        }
+
+        func format(_ histogram: MessageSendLaneScheduler.Histogram?) -> String {
+            guard let histogram else {
+                return "-"
+            }
+            return "p50=\(histogram.percentile(0.5))us p99=\(histogram.percentile(0.99))us max=\(histogram.max)us"
+        }
+
+        let laneLatencies = await runLoad(
+            scheduler: MessageSendLaneScheduler(slotCounts: [.text: 16, .media: 3, .sync: 8]),
+            mediaLane: .media,
+        )
+        let sharedLatencies = await runLoad(
+            scheduler: MessageSendLaneScheduler(slotCounts: [.text: 19, .media: 1, .sync: 1]),
+            mediaLane: .text,
+        )
+        Logger.info("With lanes: text \(format(laneLatencies[.text])); media \(format(laneLatencies[.media]))")
+        Logger.info("With one shared budget: \(format(sharedLatencies[.text]))")
+        XCTAssertEqual(laneLatencies[.text]?.count, 300)
+        XCTAssertEqual(laneLatencies[.media]?.count, 30)
+    }
+}
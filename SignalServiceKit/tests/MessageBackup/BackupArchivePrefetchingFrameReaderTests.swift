@@ -0,0 +1,105 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import XCTest
+
+@testable import SignalServiceKit
+
+class BackupArchivePrefetchingFrameReaderTests: XCTestCase {
+    private let plaintextStreamProvider = BackupArchivePlaintextProtoStreamProvider()
+
+    /// Writes a Backup file with a header and one chat frame per id.
+    private func writeBackupFile(chatIds: [UInt64]) throws -> URL {
+        let outputStream: BackupArchiveProtoOutputStream
+        let fileUrlProvider: () throws -> URL
+        switch plaintextStreamProvider.openPlaintextOutputFileStream(exportProgress: nil) {
+        case .success(let _outputStream, let _fileUrlProvider):
+            outputStream = _outputStream
+            fileUrlProvider = _fileUrlProvider
+        case .unableToOpenFileStream:
+            throw OWSAssertionError("Unable to open output stream")
+        }
+
+        var header = BackupProto_BackupInfo()
+        header.version = 1
+        guard case .success = outputStream.writeHeader(header) else {
+            throw OWSAssertionError("Failed to write header")
+        }
+        for chatId in chatIds {
+            var chat = BackupProto_Chat()
+            chat.id = chatId
+            var frame = BackupProto_Frame()
+            frame.item = .chat(chat)
+            guard case .success = outputStream.writeFrame(frame) else {
+                throw OWSAssertionError("Failed to write frame")
+            }
+        }
+        try outputStream.closeFileStream()
+        return try fileUrlProvider()
+    }
+
+    private func openBackupFile(_ fileUrl: URL) throws -> BackupArchiveProtoInputStream {
+        switch plaintextStreamProvider.openPlaintextInputFileStream(fileUrl: fileUrl, frameRestoreProgress: nil) {
+        case .success(let stream, _):
+            guard case .success = stream.readHeader() else {
+                throw OWSAssertionError("Failed to read header")
+            }
+            return stream
+        case .fileNotFound, .unableToOpenFileStream, .hmacValidationFailedOnEncryptedFile:
+            throw OWSAssertionError("Unable to open input stream")
+        }
+    }
+
+    func testReadsFramesInOrder() throws {
+        let chatIds = Array(UInt64(1)...500)
+        let fileUrl = try writeBackupFile(chatIds: chatIds)
+        defer { try? FileManager.default.removeItem(at: fileUrl) }
+
+        let stream = try openBackupFile(fileUrl)
+        let frameReader = BackupArchivePrefetchingFrameReader(stream: stream, batchSize: 7, maxPendingBatchCount: 2)
+
+        var readChatIds = [UInt64]()
+        var hasMoreFrames = true
+        while hasMoreFrames {
+            switch frameReader.readFrame() {
+            case .success(let frame, let moreBytesAvailable):
+                guard case .chat(let chat) = frame.item else {
+                    XCTFail("Unexpected frame")
+                    return
+                }
+                readChatIds.append(chat.id)
+                hasMoreFrames = moreBytesAvailable
+            case .emptyFinalFrame:
+                hasMoreFrames = false
+            case .invalidByteLengthDelimiter, .protoDeserializationError:
+                XCTFail("Failed to read frame")
+                return
+            }
+        }
+        XCTAssertEqual(readChatIds, chatIds)
+
+        // Reading past the end keeps returning the end.
+        guard case .emptyFinalFrame = frameReader.readFrame() else {
+            XCTFail("Expected the end of the stream")
+            return
+        }
+        frameReader.stop()
+        stream.closeFileStream()
+    }
+
+    func testStopBeforeReadingAllFrames() throws {
+        let fileUrl = try writeBackupFile(chatIds: Array(UInt64(1)...500))
+        defer { try? FileManager.default.removeItem(at: fileUrl) }
+
+        let stream = try openBackupFile(fileUrl)
+        let frameReader = BackupArchivePrefetchingFrameReader(stream: stream, batchSize: 7, maxPendingBatchCount: 2)
+        guard case .success = frameReader.readFrame() else {
+            XCTFail("Failed to read frame")
+            return
+        }
+        frameReader.stop()
+        stream.closeFileStream()
+    }
+}
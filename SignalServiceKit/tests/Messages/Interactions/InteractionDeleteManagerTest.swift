@@ -0,0 +1,175 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import GRDB
+import LibSignalClient
+import XCTest
+@testable import SignalServiceKit
+
+class InteractionDeleteManagerTest: SSKBaseTest {
+
+    private var interactionDeleteManager: any InteractionDeleteManager {
+        DependenciesBridge.shared.interactionDeleteManager
+    }
+
+    private func createThread(messageCount: UInt, tx: DBWriteTransaction) -> (TSThread, [TSIncomingMessage]) {
+        let thread = ContactThreadFactory().create(transaction: tx)
+        let factory = IncomingMessageFactory()
+        factory.threadCreator = { _ in thread }
+        return (thread, factory.create(count: messageCount, transaction: tx))
+    }
+
+    private func count(
+        in tableName: String,
+        where columnName: String,
+        in uniqueIds: [String],
+        tx: DBReadTransaction,
+    ) -> Int {
+        return try! Int.fetchOne(
+            tx.database,
+            sql: "SELECT COUNT(*) FROM \(tableName) WHERE \(columnName) IN (\(databaseQuestionMarks(count: uniqueIds.count)))",
+            arguments: StatementArguments(uniqueIds),
+        )!
+    }
+
+    func testDeleteInteractionsInThread() {
+        let (thread, messages) = write { tx in
+            let thread = ContactThreadFactory().create(transaction: tx)
+
+            // A story reply is deleted one at a time, alongside the others.
+            let storyReplyFactory = IncomingMessageFactory()
+            storyReplyFactory.threadCreator = { _ in thread }
+            storyReplyFactory.storyAuthorAciBuilder = { Aci.randomForTesting() }
+            storyReplyFactory.storyTimestampBuilder = { 1234 }
+            let storyReply = storyReplyFactory.create(transaction: tx)
+
+            let messageFactory = IncomingMessageFactory()
+            messageFactory.threadCreator = { _ in thread }
+            let messages = messageFactory.create(count: 10, transaction: tx)
+
+            let allMessages = [storyReply] + messages
+            for message in allMessages {
+                message.recordReaction(
+                    for: Aci.randomForTesting(),
+                    emoji: "👍",
+                    sentAtTimestamp: 1,
+                    receivedAtTimestamp: 1,
+                    tx: tx,
+                )
+            }
+            return (thread, allMessages)
+        }
+        let anchorRowId = messages[6].sqliteRowId!
+
+        // Batches are taken newest first.
+        let firstBatchCount = write { tx in
+            interactionDeleteManager.deleteInteractions(
+                threadUniqueId: thread.uniqueId,
+                atOrBeforeRowId: anchorRowId,
+                limit: 4,
+                associatedCallDelete: .localDeleteOnly,
+                tx: tx,
+            )
+        }
+        XCTAssertEqual(firstBatchCount, 4)
+        read { tx in
+            let remainingRowIds = try! Int64.fetchAll(
+                tx.database,
+                sql: "SELECT id FROM \(InteractionRecord.databaseTableName) WHERE uniqueThreadId = ? ORDER BY id",
+                arguments: [thread.uniqueId],
+            )
+            XCTAssertEqual(remainingRowIds, (messages[0..<3] + messages[7...]).map { $0.sqliteRowId! })
+        }
+
+        var deletedCount = firstBatchCount
+        while true {
+            let batchCount = write { tx in
+                interactionDeleteManager.deleteInteractions(
+                    threadUniqueId: thread.uniqueId,
+                    atOrBeforeRowId: anchorRowId,
+                    limit: 4,
+                    associatedCallDelete: .localDeleteOnly,
+                    tx: tx,
+                )
+            }
+            if batchCount == 0 {
+                break
+            }
+            deletedCount += batchCount
+        }
+        XCTAssertEqual(deletedCount, 7)
+
+        let deletedUniqueIds = messages[...6].map(\.uniqueId)
+        let keptUniqueIds = messages[7...].map(\.uniqueId)
+        read { tx in
+            XCTAssertEqual(count(in: InteractionRecord.databaseTableName, where: "uniqueId", in: deletedUniqueIds, tx: tx), 0)
+            XCTAssertEqual(count(in: InteractionRecord.databaseTableName, where: "uniqueId", in: keptUniqueIds, tx: tx), keptUniqueIds.count)
+
+            XCTAssertEqual(count(in: OWSReaction.databaseTableName, where: "uniqueMessageId", in: deletedUniqueIds, tx: tx), 0)
+            XCTAssertEqual(count(in: OWSReaction.databaseTableName, where: "uniqueMessageId", in: keptUniqueIds, tx: tx), keptUniqueIds.count)
+
+            XCTAssertEqual(count(in: FullTextSearchIndexer.contentTableName, where: FullTextSearchIndexer.uniqueIdColumn, in: deletedUniqueIds, tx: tx), 0)
+            XCTAssertEqual(count(in: FullTextSearchIndexer.contentTableName, where: FullTextSearchIndexer.uniqueIdColumn, in: keptUniqueIds, tx: tx), keptUniqueIds.count)
+        }
+    }
+
+    /// Deletes a large thread a batch at a time, logging rows per second
+    /// alongside the rate of deleting fetched interactions one at a time.
+    func testDeleteInteractionsPerformance() {
+        let messageCount: UInt = 2000
+        let batchSize = 500
+
+        func rowsPerSecond(_ deleteAll: (TSThread, Int64) -> Void) -> Int {
+            let (thread, messages) = write { tx in createThread(messageCount: messageCount, tx: tx) }
+            let startDate = MonotonicDate()
+            deleteAll(thread, messages.last!.sqliteRowId!)
+            return Int(Double(messageCount) / (MonotonicDate() - startDate).seconds)
+        }
+
+        func deleteInBatches(thread: TSThread, anchorRowId: Int64) {
+            write { tx in
+                while
+                    interactionDeleteManager.deleteInteractions(
+                        threadUniqueId: thread.uniqueId,
+                        atOrBeforeRowId: anchorRowId,
+                        limit: batchSize,
+                        associatedCallDelete: .localDeleteOnly,
+                        tx: tx,
+                    ) > 0
+                {}
+            }
+        }
+
+        let individualRate = rowsPerSecond { thread, anchorRowId in
+            write { tx in
+                while true {
+                    let interactions = try! InteractionFinder(threadUniqueId: thread.uniqueId).fetchAllInteractions(
+                        rowIdFilter: .atOrBefore(anchorRowId),
+                        limit: batchSize,
+                        tx: tx,
+                    )
+                    if interactions.isEmpty {
+                        break
+                    }
+                    interactionDeleteManager.delete(
+                        interactions: interactions,
+                        sideEffects: .custom(associatedCallDelete: .localDeleteOnly, updateThreadOnInteractionDelete: .doNotUpdate),
+                        tx: tx,
+                    )
+                }
+            }
+        }
+        let batchRate = rowsPerSecond(deleteInBatches(thread:anchorRowId:))
+        Logger.info("Deleted \(batchRate) rows per second in batches; \(individualRate) rows per second one at a time.")
+
+        measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+            let (thread, messages) = write { tx in createThread(messageCount: messageCount, tx: tx) }
+            startMeasuring()
+            deleteInBatches(thread: thread, anchorRowId: messages.last!.sqliteRowId!)
+            stopMeasuring()
+        }
+    }
+}
@@ -107,4 +107,13 @@ class TSMessageTest: SSKBaseTest {
             XCTAssertFalse(message.canBeRemotelyDeletedByNonAdmin)
         }
     }
+
+    func testWriteHookCapabilities() {
+        XCTAssertEqual(TSIncomingMessage.writeHookCapabilities, .all)
+        XCTAssertEqual(TSOutgoingMessage.writeHookCapabilities, .all)
+        XCTAssertEqual(TSInfoMessage.writeHookCapabilities, [])
+        XCTAssertEqual(OWSAddToContactsOfferMessage.writeHookCapabilities, [])
+        XCTAssertEqual(TSErrorMessage.writeHookCapabilities, [])
+        XCTAssertEqual(OWSUnknownContactBlockOfferMessage.writeHookCapabilities, [])
+    }
 }
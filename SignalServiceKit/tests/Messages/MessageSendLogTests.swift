@@ -479,7 +479,8 @@ class MessageSendLogTests: SSKBaseTest {
             return (oldId, newId)
         }
 
-        try await messageSendLog.cleanUpExpiredEntries()
+        let maintenanceScheduler = MaintenanceScheduler(db: DependenciesBridge.shared.db)
+        try await maintenanceScheduler.runUntilDone(name: "MessageSendLog", step: messageSendLog.cleanUpSomeExpiredEntries(tx:))
 
         SSKEnvironment.shared.databaseStorageRef.read { tx in
             // Verify only the old message was deleted
@@ -8,7 +8,7 @@ import XCTest
 
 class MessageSenderJobQueueTest: SSKBaseTest {
     func test_messageIsSent() async throws {
-        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock())
+        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock(), db: SSKEnvironment.shared.databaseStorageRef)
         let (message, promise) = try await SSKEnvironment.shared.databaseStorageRef.awaitableWrite { tx in
             let message = OutgoingMessageFactory().create(transaction: tx)
             let jobRecord = try MessageSenderJobRecord(
@@ -34,7 +34,7 @@ class MessageSenderJobQueueTest: SSKBaseTest {
 
     func test_respectsQueueOrder() async throws {
         let messageCount = 3
-        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock())
+        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock(), db: SSKEnvironment.shared.databaseStorageRef)
         let (messages, promises) = try await SSKEnvironment.shared.databaseStorageRef.awaitableWrite { tx in
             let contactThread = ContactThreadFactory().create(transaction: tx)
             let outgoingMessageFactory = OutgoingMessageFactory()
@@ -66,7 +66,7 @@ class MessageSenderJobQueueTest: SSKBaseTest {
     }
 
     func test_sendingInvisibleMessage() async throws {
-        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock())
+        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock(), db: SSKEnvironment.shared.databaseStorageRef)
         fakeMessageSender.stubbedFailingErrors = [nil]
         jobQueue.setUp()
         let (message, promise) = await SSKEnvironment.shared.databaseStorageRef.awaitableWrite { tx in
@@ -87,7 +87,7 @@ class MessageSenderJobQueueTest: SSKBaseTest {
     }
 
     func test_retryableFailure() async throws {
-        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock())
+        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock(), db: SSKEnvironment.shared.databaseStorageRef)
 
         let (jobRecord, message, promise) = try await SSKEnvironment.shared.databaseStorageRef.awaitableWrite { tx in
             let message = OutgoingMessageFactory().create(transaction: tx)
@@ -139,7 +139,7 @@ class MessageSenderJobQueueTest: SSKBaseTest {
     }
 
     func test_permanentFailure() async throws {
-        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock())
+        let jobQueue = MessageSenderJobQueue(appReadiness: AppReadinessMock(), db: SSKEnvironment.shared.databaseStorageRef)
 
         let (jobRecord, message, promise) = try await SSKEnvironment.shared.databaseStorageRef.awaitableWrite { tx in
             let message = OutgoingMessageFactory().create(transaction: tx)
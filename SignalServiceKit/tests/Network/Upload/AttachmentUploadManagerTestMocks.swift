@@ -28,9 +28,9 @@ class _Upload_AttachmentEncrypterMock: Upload.Shims.AttachmentEncrypter {
         return encryptAttachmentBlock!(unencryptedUrl, encryptedUrl)
     }
 
-    var decryptAttachmentBlock: ((URL, DecryptionMetadata, URL) -> Void)?
-    func decryptAttachment(at encryptedUrl: URL, metadata: DecryptionMetadata, output: URL) throws {
-        return decryptAttachmentBlock!(encryptedUrl, metadata, output)
+    var reencryptAttachmentBlock: ((URL, DecryptionMetadata, URL) -> EncryptionMetadata)?
+    func reencryptAttachment(at encryptedUrl: URL, metadata: DecryptionMetadata, output encryptedOutputUrl: URL) throws -> EncryptionMetadata {
+        return reencryptAttachmentBlock!(encryptedUrl, metadata, encryptedOutputUrl)
     }
 }
 
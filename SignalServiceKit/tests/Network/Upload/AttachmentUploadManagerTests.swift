@@ -558,14 +558,10 @@ struct AttachmentUploadManagerTests {
             mockAttachment: attachment,
         )
 
-        var didDecrypt = false
-        helper.mockAttachmentEncrypter.decryptAttachmentBlock = { _, encryptionMetadata, _ in
-            didDecrypt = true
-            #expect(encryptionMetadata.key.combinedKey == attachment.encryptionKey)
-        }
-        var didEncrypt = false
-        helper.mockAttachmentEncrypter.encryptAttachmentBlock = { _, _ in
-            didEncrypt = true
+        var didReencrypt = false
+        helper.mockAttachmentEncrypter.reencryptAttachmentBlock = { _, decryptionMetadata, _ in
+            didReencrypt = true
+            #expect(decryptionMetadata.key.combinedKey == attachment.encryptionKey)
             return EncryptionMetadata(
                 key: try! AttachmentKey(combinedKey: Data(count: 64)),
                 digest: Data(),
@@ -603,8 +599,7 @@ struct AttachmentUploadManagerTests {
             #expect(request.allHTTPHeaderFields!["Content-Length"] == "\(encryptedSize)")
         } else { Issue.record("Unexpected request encountered.") }
 
-        #expect(didDecrypt)
-        #expect(didEncrypt)
+        #expect(didReencrypt)
     }
 
     @Test(arguments: CDNEndpoint.allCases)
@@ -624,14 +619,10 @@ struct AttachmentUploadManagerTests {
             mockAttachment: attachment,
         )
 
-        var didDecrypt = false
-        helper.mockAttachmentEncrypter.decryptAttachmentBlock = { _, encryptionMetadata, _ in
-            didDecrypt = true
-            #expect(encryptionMetadata.key.combinedKey == attachment.encryptionKey)
-        }
-        var didEncrypt = false
-        helper.mockAttachmentEncrypter.encryptAttachmentBlock = { _, _ in
-            didEncrypt = true
+        var didReencrypt = false
+        helper.mockAttachmentEncrypter.reencryptAttachmentBlock = { _, decryptionMetadata, _ in
+            didReencrypt = true
+            #expect(decryptionMetadata.key.combinedKey == attachment.encryptionKey)
             return EncryptionMetadata(
                 key: try! AttachmentKey(combinedKey: Data(count: 64)),
                 digest: Data(),
@@ -669,7 +660,6 @@ struct AttachmentUploadManagerTests {
             #expect(request.allHTTPHeaderFields!["Content-Length"] == "\(encryptedSize)")
         } else { Issue.record("Unexpected request encountered.") }
 
-        #expect(didDecrypt)
-        #expect(didEncrypt)
+        #expect(didReencrypt)
     }
 }
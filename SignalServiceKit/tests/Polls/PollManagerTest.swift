@@ -25,7 +25,7 @@ struct PollManagerTest {
             recipientDatabaseTable: RecipientDatabaseTable(),
             interactionStore: InteractionStoreImpl(),
             accountManager: mockTSAccountManager,
-            messageSenderJobQueue: MessageSenderJobQueue(appReadiness: AppReadinessMock()),
+            messageSenderJobQueue: MessageSenderJobQueue(appReadiness: AppReadinessMock(), db: db),
             disappearingMessagesConfigurationStore: MockDisappearingMessagesConfigurationStore(),
             attachmentContentValidator: AttachmentContentValidatorMock(),
             db: db,
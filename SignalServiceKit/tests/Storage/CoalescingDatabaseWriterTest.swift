@@ -0,0 +1,94 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+@testable import SignalServiceKit
+
+class CoalescingDatabaseWriterTest: SSKBaseTest {
+
+    private let kvStore = KeyValueStore(collection: "CoalescingDatabaseWriterTest")
+
+    private struct WriteError: Error {}
+
+    /// Writes `count` values concurrently, as a fan-out send does.
+    private func writeConcurrently(count: Int, using write: @escaping (@escaping (DBWriteTransaction) throws -> Int) async throws -> Int) async throws -> [Int] {
+        let kvStore = self.kvStore
+        return try await withThrowingTaskGroup(of: Int.self) { taskGroup in
+            for value in 0..<count {
+                taskGroup.addTask {
+                    return try await write { tx in
+                        kvStore.setInt(value, key: "\(value)", transaction: tx)
+                        return value
+                    }
+                }
+            }
+            return try await taskGroup.reduce(into: []) { $0.append($1) }
+        }
+    }
+
+    func testConcurrentWrites() async throws {
+        let writer = CoalescingDatabaseWriter(db: SSKEnvironment.shared.databaseStorageRef, maxBatchSize: 4)
+        let values = try await writeConcurrently(count: 50) { block in
+            return try await writer.write(block)
+        }
+        XCTAssertEqual(Set(values), Set(0..<50))
+        SSKEnvironment.shared.databaseStorageRef.read { tx in
+            for value in 0..<50 {
+                XCTAssertEqual(kvStore.getInt("\(value)", transaction: tx), value)
+            }
+        }
+    }
+
+    func testFailedWriteDoesNotAffectOthers() async {
+        let writer = CoalescingDatabaseWriter(db: SSKEnvironment.shared.databaseStorageRef)
+        let results = await withTaskGroup(of: Result<Int, any Error>.self) { taskGroup in
+            for value in 0..<10 {
+                taskGroup.addTask {
+                    do {
+                        return .success(try await writer.write { tx in
+                            self.kvStore.setInt(value, key: "\(value)", transaction: tx)
+                            if value.isMultiple(of: 2) {
+                                throw WriteError()
+                            }
+                            return value
+                        })
+                    } catch {
+                        return .failure(error)
+                    }
+                }
+            }
+            return await taskGroup.reduce(into: []) { $0.append($1) }
+        }
+        XCTAssertEqual(results.filter { (try? $0.get()) == nil }.count, 5)
+        XCTAssertEqual(Set(results.compactMap { try? $0.get() }), [1, 3, 5, 7, 9])
+        // Like awaitableWrite, what a failed write did before throwing is kept.
+        SSKEnvironment.shared.databaseStorageRef.read { tx in
+            XCTAssertEqual(kvStore.getInt("2", transaction: tx), 2)
+        }
+    }
+
+    /// Logs how long fanning out writes takes as the fan-out grows, with and
+    /// without sharing transactions.
+    func testCoalescedWritePerformance() async throws {
+        let databaseStorage = SSKEnvironment.shared.databaseStorageRef
+        for count in [10, 100, 1000] {
+            var startDate = MonotonicDate()
+            _ = try await writeConcurrently(count: count) { block in
+                return try await databaseStorage.awaitableWrite(block: block)
+            }
+            let separateDuration = (MonotonicDate() - startDate).seconds
+
+            let writer = CoalescingDatabaseWriter(db: databaseStorage)
+            startDate = MonotonicDate()
+            _ = try await writeConcurrently(count: count) { block in
+                return try await writer.write(block)
+            }
+            let coalescedDuration = (MonotonicDate() - startDate).seconds
+
+            Logger.info("Wrote \(count) concurrent writes in \(Int(coalescedDuration * 1000))ms coalesced; \(Int(separateDuration * 1000))ms in separate transactions.")
+        }
+    }
+}
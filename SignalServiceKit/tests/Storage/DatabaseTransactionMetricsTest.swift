@@ -0,0 +1,98 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import Testing
+
+@testable import SignalServiceKit
+
+struct DatabaseTransactionMetricsTest {
+    @Test
+    func testHistogram() {
+        var histogram = DatabaseTransactionMetrics.Histogram()
+        #expect(histogram.percentile(0.5) == 0)
+
+        for value: UInt64 in [0, 1, 2, 3, 100, 1000] {
+            histogram.record(value)
+        }
+        #expect(histogram.count == 6)
+        #expect(histogram.sum == 1106)
+        #expect(histogram.max == 1000)
+        #expect(histogram.mean == 184)
+        // The 3rd value (2) lands in the [2, 4) bucket.
+        #expect(histogram.percentile(0.5) == 3)
+        // The 5th value (100) lands in the [64, 128) bucket.
+        #expect(histogram.percentile(0.8) == 127)
+        // Clamped to the largest recorded value.
+        #expect(histogram.percentile(1) == 1000)
+    }
+
+    @Test
+    func testHistogramHugeValues() {
+        var histogram = DatabaseTransactionMetrics.Histogram()
+        histogram.record(.max)
+        histogram.record(.max)
+        #expect(histogram.sum == .max)
+        #expect(histogram.percentile(0.5) == (1 << 39) - 1)
+    }
+
+    @Test
+    func testRecordPerCallSite() {
+        let metrics = DatabaseTransactionMetrics(isEnabled: true)
+        let requestDate = MonotonicDate()
+        let blockStartDate = requestDate.adding(0.002)
+        let blockEndDate = blockStartDate.adding(0.010)
+
+        for _ in 0..<3 {
+            metrics.record(
+                DatabaseTransactionMetrics.Measurement(
+                    requestDate: requestDate,
+                    blockStartDate: blockStartDate,
+                    blockEndDate: blockEndDate,
+                    rowsTouched: 4,
+                    writeHookNanos: 1_000_000,
+                ),
+                kind: .write,
+                file: "/tmp/Foo.swift",
+                function: "foo()",
+                line: 12,
+            )
+        }
+        metrics.record(
+            DatabaseTransactionMetrics.Measurement(
+                requestDate: requestDate,
+                blockStartDate: requestDate,
+                blockEndDate: blockStartDate,
+            ),
+            kind: .read,
+            file: "/tmp/Foo.swift",
+            function: "foo()",
+            line: 12,
+        )
+
+        let snapshot = metrics.snapshot()
+        #expect(snapshot.count == 2)
+
+        let writeMetrics = snapshot[0]
+        #expect(writeMetrics.callSite.kind == .write)
+        #expect(writeMetrics.blockMicros.count == 3)
+        #expect(writeMetrics.blockMicros.max == 10_000)
+        #expect(writeMetrics.waitMicros.max == 2_000)
+        #expect(writeMetrics.rowsTouched.mean == 4)
+        #expect(writeMetrics.writeHookMicros.sum == 3_000)
+        #expect(
+            DatabaseTransactionMetrics.summaryLine(writeMetrics)
+                == "write [Foo.swift:12 foo()] n=3 wait=2.0ms/2.0ms/2.0ms block=10.0ms/10.0ms/10.0ms rows=4/4 hooks=3.0ms",
+        )
+
+        let readMetrics = snapshot[1]
+        #expect(readMetrics.callSite.kind == .read)
+        #expect(readMetrics.rowsTouched.count == 0)
+        #expect(readMetrics.writeHookMicros.count == 0)
+
+        metrics.reset()
+        #expect(metrics.snapshot().isEmpty)
+    }
+}
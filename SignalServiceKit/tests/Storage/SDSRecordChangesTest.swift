@@ -0,0 +1,106 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import GRDB
+import XCTest
+@testable import SignalServiceKit
+
+class SDSRecordChangesTest: SSKBaseTest {
+
+    private func fetchRecord(_ interaction: TSInteraction, tx: DBReadTransaction) -> InteractionRecord {
+        let sql = "SELECT * FROM \(InteractionRecord.databaseTableName) WHERE \(interactionColumn: .uniqueId) = ?"
+        return try! InteractionRecord.fetchOne(tx.database, sql: sql, arguments: [interaction.uniqueId])!
+    }
+
+    private func fetchMessage(_ message: TSMessage, tx: DBReadTransaction) -> TSMessage {
+        return TSInteraction.anyFetch(uniqueId: message.uniqueId, transaction: tx) as! TSMessage
+    }
+
+    func testUpdateWritesOnlyChangedColumns() {
+        write { tx in
+            let message = IncomingMessageFactory().create(transaction: tx)
+            let recordBefore = fetchRecord(message, tx: tx)
+
+            message.update(with: OWSLinkPreview(urlString: "https://signal.org", title: "Signal"), transaction: tx)
+
+            let recordAfter = fetchRecord(message, tx: tx)
+            XCTAssertEqual(SDSRecordChanges(from: recordBefore, to: recordAfter).columnNames, ["linkPreview"])
+            XCTAssertEqual(recordAfter.body, recordBefore.body)
+            XCTAssertEqual(fetchMessage(message, tx: tx).linkPreview?.title, "Signal")
+        }
+    }
+
+    func testUpdateDoesNotClobberOtherChanges() {
+        write { tx in
+            let message = IncomingMessageFactory().create(transaction: tx)
+            let staleCopy = fetchMessage(message, tx: tx)
+
+            message.update(withMessageBody: "Updated body", transaction: tx)
+            staleCopy.update(with: OWSLinkPreview(urlString: "https://signal.org", title: "Signal"), transaction: tx)
+
+            let dbCopy = fetchMessage(message, tx: tx)
+            XCTAssertEqual(dbCopy.body, "Updated body")
+            XCTAssertEqual(dbCopy.linkPreview?.title, "Signal")
+        }
+    }
+
+    func testUnchangedUpdateStillTouchesRow() {
+        write { tx in
+            let record = fetchRecord(IncomingMessageFactory().create(transaction: tx), tx: tx)
+            let changesCountBefore = tx.database.totalChangesCount
+
+            record.sdsUpdateChangedColumns(from: record, transaction: tx)
+
+            XCTAssertEqual(tx.database.totalChangesCount - changesCountBefore, 1)
+        }
+    }
+
+    func testStatementCacheKeysOnRecordTypeAndColumns() {
+        let record = write { tx in
+            fetchRecord(IncomingMessageFactory().create(transaction: tx), tx: tx)
+        }
+        let cache = SDSUpdateStatementCache()
+        let sql = cache.sql(for: record, columnNames: ["body", "linkPreview"])
+        XCTAssertEqual(sql, #"UPDATE "model_TSInteraction" SET "body" = ?, "linkPreview" = ? WHERE id = ?"#)
+        XCTAssertEqual(cache.sql(for: record, columnNames: ["body", "linkPreview"]), sql)
+        XCTAssertNotEqual(cache.sql(for: record, columnNames: ["body"]), sql)
+    }
+
+    /// Changes one small column of wide rows, logging the bytes bound per
+    /// update alongside the bytes a full-row update would bind.
+    func testSingleColumnUpdatePerformance() {
+        let messages = write { tx in
+            let factory = IncomingMessageFactory()
+            factory.messageBodyBuilder = { (0..<8).map { _ in CommonGenerator.paragraph }.joined(separator: "\n") }
+            return factory.create(count: 100, transaction: tx)
+        }
+
+        func updateLinkPreviews(title: String) {
+            write { tx in
+                for message in messages {
+                    message.update(with: OWSLinkPreview(urlString: "https://signal.org", title: title), transaction: tx)
+                }
+            }
+        }
+
+        let recordsBefore = read { tx in messages.map { fetchRecord($0, tx: tx) } }
+        updateLinkPreviews(title: "Signal")
+        let recordsAfter = read { tx in messages.map { fetchRecord($0, tx: tx) } }
+
+        let updateByteCount = zip(recordsBefore, recordsAfter).reduce(0) { $0 + SDSRecordChanges(from: $1.0, to: $1.1).byteCount }
+        let rowByteCount = recordsAfter.reduce(0) { byteCount, record in
+            byteCount + record.databaseDictionary.values.reduce(0) { $0 + SDSRecordChanges.byteCount(of: $1) }
+        }
+        Logger.info("Bound \(updateByteCount) bytes for \(messages.count) single column updates; full-row updates would bind \(rowByteCount) bytes.")
+        XCTAssertLessThan(updateByteCount * 4, rowByteCount)
+
+        var iteration = 0
+        measure {
+            iteration += 1
+            updateLinkPreviews(title: "Title \(iteration)")
+        }
+    }
+}
@@ -0,0 +1,105 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+@testable import SignalServiceKit
+
+class WriteHookCostAccountingTest: SSKBaseTest {
+
+    private var accounting: WriteHookCostAccounting {
+        SSKEnvironment.shared.databaseStorageRef.writeHookCostAccounting
+    }
+
+    override func tearDown() {
+        accounting.isEnabled = false
+        accounting.reset()
+        super.tearDown()
+    }
+
+    func testDisabledByDefault() {
+        write { tx in
+            let thread = ContactThreadFactory().create(transaction: tx)
+            TSInfoMessage(thread: thread, messageType: .userJoinedSignal).anyInsert(transaction: tx)
+        }
+        XCTAssertTrue(accounting.snapshot().isEmpty)
+    }
+
+    func testAccountsPerClassAndHook() {
+        let thread = write { tx in ContactThreadFactory().create(transaction: tx) }
+
+        accounting.isEnabled = true
+        write { tx in
+            let infoMessage = TSInfoMessage(thread: thread, messageType: .userJoinedSignal)
+            infoMessage.anyInsert(transaction: tx)
+
+            let incomingMessageFactory = IncomingMessageFactory()
+            incomingMessageFactory.threadCreator = { _ in thread }
+            let incomingMessages = incomingMessageFactory.create(count: 2, transaction: tx)
+            incomingMessages[0].anyOverwritingUpdate(transaction: tx)
+        }
+
+        let entries = accounting.snapshot()
+        func entry(_ modelClass: AnyClass, _ hook: WriteHook) -> WriteHookCostAccounting.Entry? {
+            return entries.first { $0.className == String(describing: modelClass) && $0.hook == hook }
+        }
+        XCTAssertEqual(entry(TSInfoMessage.self, .willInsert)?.count, 1)
+        XCTAssertEqual(entry(TSInfoMessage.self, .didInsert)?.count, 1)
+        XCTAssertEqual(entry(TSIncomingMessage.self, .willInsert)?.count, 2)
+        XCTAssertEqual(entry(TSIncomingMessage.self, .didInsert)?.count, 2)
+        XCTAssertEqual(entry(TSIncomingMessage.self, .willUpdate)?.count, 1)
+        XCTAssertEqual(entry(TSIncomingMessage.self, .didUpdate)?.count, 1)
+        XCTAssertNil(entry(TSInfoMessage.self, .willUpdate))
+
+        accounting.reset()
+        XCTAssertTrue(accounting.snapshot().isEmpty)
+    }
+
+    /// Inserts a mix of interactions and logs where the write hook time went.
+    func testMixedInteractionInsertPerformance() {
+        let thread = write { tx in ContactThreadFactory().create(transaction: tx) }
+
+        let incomingMessageFactory = IncomingMessageFactory()
+        incomingMessageFactory.threadCreator = { _ in thread }
+        let outgoingMessageFactory = OutgoingMessageFactory()
+        outgoingMessageFactory.threadCreator = { _ in thread }
+
+        accounting.isEnabled = true
+        measure {
+            write { tx in
+                for index in 0..<100 {
+                    switch index % 5 {
+                    case 0:
+                        _ = incomingMessageFactory.create(transaction: tx)
+                    case 1:
+                        _ = outgoingMessageFactory.create(transaction: tx)
+                    case 2:
+                        TSInfoMessage(thread: thread, messageType: .userJoinedSignal).anyInsert(transaction: tx)
+                    case 3:
+                        TSErrorMessage.sessionRefresh(thread: thread).anyInsert(transaction: tx)
+                    default:
+                        TSCall(
+                            callType: .incoming,
+                            offerType: .audio,
+                            thread: thread,
+                            sentAtTimestamp: Date.ows_millisecondTimestamp(),
+                            expiresInSeconds: 0,
+                        ).anyInsert(transaction: tx)
+                    }
+                }
+            }
+        }
+        accounting.logSummary()
+
+        let classNames = Set(accounting.snapshot().map(\.className))
+        XCTAssertTrue(classNames.isSuperset(of: [
+            String(describing: TSIncomingMessage.self),
+            String(describing: TSOutgoingMessage.self),
+            String(describing: TSInfoMessage.self),
+            String(describing: TSErrorMessage.self),
+            String(describing: TSCall.self),
+        ]))
+    }
+}
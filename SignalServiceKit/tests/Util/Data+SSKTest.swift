@@ -78,6 +78,15 @@ struct DataSSKTest {
         #expect(inputData == Data(testCase.remainingData))
     }
 
+    @Test(arguments: [0, 1, 127, 128, 300, UInt64(UInt32.max), UInt64.max] as [UInt64])
+    func testEncodeVarint(value: UInt64) throws {
+        var data = Data()
+        data.appendVarint(value)
+        data.append(7)
+        #expect(try data.removeFirstVarint() == value)
+        #expect(data == Data([7]))
+    }
+
     @Test(arguments: [
         ([], .truncated),
         ([128], .truncated),
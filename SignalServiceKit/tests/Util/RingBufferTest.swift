@@ -0,0 +1,52 @@
+//
+// Copyright 2026 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import Testing
+
+@testable import SignalServiceKit
+
+struct RingBufferTest {
+    @Test
+    func testBasic() {
+        var ringBuffer = RingBuffer<String>(minimumCapacity: 2)
+        #expect(ringBuffer.isEmpty)
+        #expect(ringBuffer.prefix(4) == [])
+        ringBuffer.append("A")
+        ringBuffer.append("B")
+        #expect(ringBuffer.prefix(1) == ["A"])
+        ringBuffer.removeFirst(1)
+        ringBuffer.append("C")
+        // Wraps around the end of the buffer.
+        #expect(ringBuffer.capacity == 2)
+        #expect(ringBuffer.prefix(4) == ["B", "C"])
+        ringBuffer.removeFirst(2)
+        #expect(ringBuffer.isEmpty)
+    }
+
+    @Test
+    func testResizing() {
+        var ringBuffer = RingBuffer<Int>(minimumCapacity: 4)
+        ringBuffer.append(-1)
+        ringBuffer.removeFirst(1)
+        for value in 0..<100 {
+            ringBuffer.append(value)
+        }
+        #expect(ringBuffer.count == 100)
+        #expect(ringBuffer.capacity == 128)
+        #expect(ringBuffer.prefix(3) == [0, 1, 2])
+
+        ringBuffer.removeFirst(90)
+        #expect(ringBuffer.prefix(20) == Array(90..<100))
+        #expect(ringBuffer.capacity == 64)
+        ringBuffer.removeFirst(9)
+        #expect(ringBuffer.prefix(20) == [99])
+        #expect(ringBuffer.capacity == 32)
+
+        ringBuffer.removeAll()
+        #expect(ringBuffer.isEmpty)
+        #expect(ringBuffer.capacity == 4)
+    }
+}
@@ -28,6 +28,178 @@ final class TransformingOutputStreamTests: XCTestCase {
         XCTAssertEqual(expected, String(data: outputStream.accumulation, encoding: .utf8))
     }
 
+    func testPipelinedStagesMatchSingleStage() throws {
+        let chunks = (0..<200).map { Randomness.generateRandomBytes(UInt($0 * 37 % 1000)) }
+        let key = Randomness.generateRandomBytes(32)
+        let iv = Randomness.generateRandomBytes(16)
+
+        let expectedOutputStream = TextBackedOutputStream()
+        let singleStageStream = TransformingOutputStream(
+            transforms: [
+                ChunkedOutputStreamTransform(),
+                try EncryptingStreamTransform(iv: iv, encryptionKey: key),
+                try HmacStreamTransform(hmacKey: key, operation: .generate),
+            ],
+            outputStream: expectedOutputStream,
+        )
+        for chunk in chunks {
+            try singleStageStream.write(data: chunk)
+        }
+        try singleStageStream.close()
+
+        let outputStream = TextBackedOutputStream()
+        let hmacStage = TransformingOutputStream(
+            transforms: [try HmacStreamTransform(hmacKey: key, operation: .generate)],
+            outputStream: outputStream,
+        )
+        let encryptStage = TransformingOutputStream(
+            transforms: [try EncryptingStreamTransform(iv: iv, encryptionKey: key)],
+            outputStream: PipelinedOutputStream(outputStream: hmacStage, label: "hmac", blockSize: 100, maxPendingBlockCount: 2),
+        )
+        let chunkStage = TransformingOutputStream(
+            transforms: [ChunkedOutputStreamTransform()],
+            outputStream: PipelinedOutputStream(outputStream: encryptStage, label: "encrypt", blockSize: 1000, maxPendingBlockCount: 2),
+        )
+        for chunk in chunks {
+            try chunkStage.write(data: chunk)
+        }
+        try chunkStage.close()
+
+        XCTAssertEqual(outputStream.accumulation, expectedOutputStream.accumulation)
+        XCTAssertEqual(chunkStage.inputByteCount, UInt64(chunks.reduce(0) { $0 + $1.count }))
+    }
+
+    func testPipelinedStreamRethrowsDownstreamError() throws {
+        let failingStream = FailingOutputStream()
+        let pipelinedStream = PipelinedOutputStream(
+            outputStream: failingStream,
+            label: "failing",
+            blockSize: 10,
+        )
+        try pipelinedStream.write(data: Data(count: 10))
+        XCTAssertThrowsError(try pipelinedStream.flush())
+        XCTAssertThrowsError(try pipelinedStream.write(data: Data(count: 10)))
+        XCTAssertThrowsError(try pipelinedStream.close())
+        XCTAssertTrue(failingStream.isClosed)
+    }
+
+    private func makeBackupTransforms(key: Data, iv: Data) throws -> [any StreamTransform] {
+        return [
+            ChunkedOutputStreamTransform(),
+            try EncryptingStreamTransform(iv: iv, encryptionKey: key),
+            try HmacStreamTransform(hmacKey: key, operation: .generate),
+            MetadataStreamTransform(),
+        ]
+    }
+
+    func testBufferPassingMatchesAllocatingTransforms() throws {
+        let chunks = (0..<200).map { Randomness.generateRandomBytes(UInt($0 * 37 % 1000)) }
+        let key = Randomness.generateRandomBytes(32)
+        let iv = Randomness.generateRandomBytes(16)
+
+        let allocatingTransforms = try makeBackupTransforms(key: key, iv: iv)
+        var expectedOutput = Data()
+        for chunk in chunks {
+            expectedOutput.append(try allocatingTransforms.reduce(chunk) { try $1.transform(data: $0) })
+        }
+
+        let bufferPassingTransforms = try makeBackupTransforms(key: key, iv: iv)
+        var buffers = Array(repeating: Data(), count: bufferPassingTransforms.count)
+        var output = Data()
+        for chunk in chunks {
+            output.append(try bufferPassingTransforms.transform(data: chunk, reusing: &buffers))
+        }
+
+        XCTAssertEqual(output, expectedOutput)
+    }
+
+    func testBufferPassingReusesBuffers() throws {
+        let transforms = try makeBackupTransforms(
+            key: Randomness.generateRandomBytes(32),
+            iv: Randomness.generateRandomBytes(16),
+        )
+        var buffers = Array(repeating: Data(), count: transforms.count)
+        let chunk = Randomness.generateRandomBytes(64 * 1024)
+
+        // The first call writes the IV, and sizes the buffers.
+        _ = try transforms.transform(data: chunk, reusing: &buffers)
+        _ = try transforms.transform(data: chunk, reusing: &buffers)
+        // Transforms that pass data through leave their buffers empty.
+        func bufferAddresses() -> [UnsafeRawPointer?] {
+            return buffers.filter { !$0.isEmpty }.map { $0.withUnsafeBytes { $0.baseAddress } }
+        }
+        let initialBufferAddresses = bufferAddresses()
+        XCTAssertEqual(initialBufferAddresses.count, 2)
+        for _ in 0..<10 {
+            _ = try transforms.transform(data: chunk, reusing: &buffers)
+        }
+        XCTAssertEqual(bufferAddresses(), initialBufferAddresses)
+    }
+
+    /// Streams 8 MiB through the backup export transforms, allocating a new
+    /// `Data` at each step.
+    func testAllocatingTransformsPerformance() throws {
+        try measureBackupTransforms { transforms in
+            return { chunk in
+                _ = try transforms.reduce(chunk) { try $1.transform(data: $0) }
+            }
+        }
+    }
+
+    /// Streams 8 MiB through the backup export transforms, reusing buffers.
+    /// Compare allocations and peak memory against the allocating version.
+    func testBufferPassingTransformsPerformance() throws {
+        try measureBackupTransforms { transforms in
+            var buffers = Array(repeating: Data(), count: transforms.count)
+            return { chunk in
+                _ = try transforms.transform(data: chunk, reusing: &buffers)
+            }
+        }
+    }
+
+    private func measureBackupTransforms(
+        _ makeTransformChunk: @escaping ([any StreamTransform]) -> (Data) throws -> Void,
+    ) throws {
+        let chunkSize = 64 * 1024
+        let chunkCount = (8 << 20) / chunkSize
+        let chunk = Randomness.generateRandomBytes(UInt(chunkSize))
+        let key = Randomness.generateRandomBytes(32)
+        let iv = Randomness.generateRandomBytes(16)
+
+        var thrownError: Error?
+        measure(metrics: [XCTClockMetric(), XCTCPUMetric(), XCTMemoryMetric()]) {
+            do {
+                let transformChunk = makeTransformChunk(try makeBackupTransforms(key: key, iv: iv))
+                for _ in 0..<chunkCount {
+                    try autoreleasepool {
+                        try transformChunk(chunk)
+                    }
+                }
+            } catch {
+                thrownError = error
+            }
+        }
+        if let thrownError {
+            throw thrownError
+        }
+    }
+
+    private class FailingOutputStream: OutputStreamable {
+        var isClosed = false
+
+        func write(data: Data) throws {
+            throw OWSGenericError("Failed to write")
+        }
+
+        func close() throws {
+            isClosed = true
+        }
+
+        func remove(from: RunLoop, forMode: RunLoop.Mode) {}
+
+        func schedule(in: RunLoop, forMode: RunLoop.Mode) {}
+    }
+
     private class TestStreamTransform1: StreamTransform, FinalizableStreamTransform {
         var hasPendingBytes: Bool { false }
         var hasFinalized = false